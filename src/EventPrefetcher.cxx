@@ -0,0 +1,113 @@
+/** \class hcana::EventPrefetcher
+    \ingroup Base
+
+\brief Background read-ahead of raw CODA event buffers
+
+Used by hcana::Scandalizer to overlap disk reads with decoding and analysis.
+Multi-block buffers are handed out whole; splitting them into events stays
+with the decoder on the analysis thread.
+
+*/
+#include "EventPrefetcher.h"
+
+namespace hcana {
+
+EventPrefetcher::EventPrefetcher(THaRunBase* run, size_t depth)
+  : fRun(run), fRing(depth < 2 ? 2 : depth)
+{
+}
+
+EventPrefetcher::~EventPrefetcher()
+{
+  Stop();
+}
+
+void EventPrefetcher::Start()
+{
+  if( fThread.joinable() ) {
+    return;
+  }
+  fHead = fTail = fCount = 0;
+  fInUse = fStop = false;
+  fThread = std::thread(&EventPrefetcher::ReadLoop, this);
+}
+
+void EventPrefetcher::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fFreed.notify_all();
+  if( fThread.joinable() ) {
+    fThread.join();
+  }
+}
+
+void EventPrefetcher::ReadLoop()
+{
+  // Reader thread.  Stops at EOF or a fatal read error, after queuing it.
+  while( true ) {
+    size_t islot;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fFreed.wait(lock, [this] { return fStop || fCount < fRing.size(); });
+      if( fStop ) {
+        break;
+      }
+      islot = fTail;
+    }
+
+    // Read outside the lock; this slot is not visible to the analysis yet
+    Slot& slot = fRing[islot];
+    slot.status = fRun->ReadEvent();
+    if( slot.status == THaRunBase::READ_OK ) {
+      const UInt_t* buf = fRun->GetEvBuffer();
+      // First word of a CODA event is its length in words, excluding itself
+      slot.data.assign(buf, buf + buf[0] + 1);
+    }
+
+    bool last = (slot.status == THaRunBase::READ_EOF ||
+                 slot.status == THaRunBase::READ_FATAL);
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fTail = (fTail + 1) % fRing.size();
+      fCount++;
+    }
+    fFilled.notify_one();
+    if( last ) {
+      break;
+    }
+  }
+}
+
+Int_t EventPrefetcher::Next(const UInt_t*& evbuffer)
+{
+  // Hand the next buffer to the analysis and return its read status.
+  // Releases the buffer returned by the previous call.
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  if( fInUse ) {
+    fCount--;
+    fInUse = false;
+    fFreed.notify_one();
+  }
+  fFilled.wait(lock, [this] { return fCount > 0 || !fThread.joinable(); });
+  if( fCount == 0 ) {
+    evbuffer = nullptr;
+    return THaRunBase::READ_EOF;
+  }
+  Slot& slot = fRing[fHead];
+  fHead = (fHead + 1) % fRing.size();
+  fInUse = true;
+  evbuffer = slot.data.data();
+  Int_t status = slot.status;
+  if( status == THaRunBase::READ_EOF || status == THaRunBase::READ_FATAL ) {
+    // Keep returning the final status
+    fInUse = false;
+    fHead = (fHead + fRing.size() - 1) % fRing.size();
+  }
+  return status;
+}
+
+} // namespace hcana
@@ -0,0 +1,53 @@
+#ifndef hcana_EventPrefetcher_h_
+#define hcana_EventPrefetcher_h_
+
+#include "THaRunBase.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hcana {
+
+  /** \brief Reads raw CODA event buffers ahead of the analysis.
+   *
+   * A background thread calls THaRunBase::ReadEvent and copies each buffer
+   * into a ring of `depth` slots.  The analysis thread takes buffers from
+   * the ring with Next(), so file reads overlap with decoding and analysis.
+   * The buffer returned by Next() stays valid until the following call.
+   * While the prefetcher runs, nothing else may read from the run.
+   */
+  class EventPrefetcher {
+  public:
+    EventPrefetcher(THaRunBase* run, size_t depth = 8);
+    virtual ~EventPrefetcher();
+
+    void  Start();
+    void  Stop();
+    Int_t Next(const UInt_t*& evbuffer);
+
+    size_t GetDepth() const { return fRing.size(); }
+
+  private:
+    struct Slot {
+      std::vector<UInt_t> data;
+      Int_t               status;
+    };
+
+    void ReadLoop();
+
+    THaRunBase*             fRun;
+    std::vector<Slot>       fRing;
+    size_t                  fHead  = 0;     // Next slot to hand out
+    size_t                  fTail  = 0;     // Next slot to fill
+    size_t                  fCount = 0;     // Filled slots, including the one in use
+    bool                    fInUse = false; // Analysis holds the slot before fHead
+    bool                    fStop  = false;
+    std::mutex              fMutex;
+    std::condition_variable fFilled;
+    std::condition_variable fFreed;
+    std::thread             fThread;
+  };
+
+} // namespace hcana
+#endif
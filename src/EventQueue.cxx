@@ -0,0 +1,55 @@
+/** \class hcana::EventQueue
+    \ingroup Base
+
+\brief Lock-free queue handing raw events from the ET reader thread to the
+analysis in hcana::OnlineMonitor
+
+*/
+#include "EventQueue.h"
+#include <chrono>
+#include <thread>
+
+namespace hcana {
+
+EventQueue::EventQueue(size_t depth)
+  : fSlots(depth < 1 ? 2 : depth + 1), fHead(0), fTail(0)
+{
+}
+
+size_t EventQueue::Detach(const std::atomic<bool> &running)
+{
+  // Make the queue independent of the memory of the pushed events.  The
+  // events the consumer has not started on are copied into their slots.
+  // The event the consumer is analyzing may still be read in place, so
+  // wait until it is popped.  While copying, the consumer can move on to
+  // events that were not copied yet; it is then on one of them when the
+  // copying ends, and the same wait covers it.  Stop waiting when running
+  // goes false, the consumer has stopped by then.
+  // Returns the number of events copied.
+
+  size_t nslots = fSlots.size();
+  size_t tail = fTail.load(std::memory_order_relaxed);
+  size_t head = fHead.load(std::memory_order_acquire);
+  if (head == tail)
+    return 0;
+
+  size_t ncopied = 0;
+  for (size_t i = (head + 1) % nslots; i != tail; i = (i + 1) % nslots) {
+    Slot &slot = fSlots[i];
+    if (slot.owned)
+      continue;
+    const uint32_t *buf = slot.data.load(std::memory_order_relaxed);
+    slot.copy.assign(buf, buf + slot.nwords);
+    slot.owned = true;
+    slot.data.store(slot.copy.data(), std::memory_order_release);
+    ncopied++;
+  }
+
+  size_t busy = fHead.load(std::memory_order_acquire);
+  while (busy != tail && running &&
+         fHead.load(std::memory_order_acquire) == busy)
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  return ncopied;
+}
+
+} // namespace hcana
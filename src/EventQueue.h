@@ -0,0 +1,83 @@
+#ifndef hcana_EventQueue_h_
+#define hcana_EventQueue_h_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hcana {
+
+  /** \brief Lock-free single-producer/single-consumer queue of raw events.
+   *
+   * Push() queues a view of an event in the producer's memory, e.g. an
+   * event of a PRadETChannel batch; nothing is copied.  The consumer reads
+   * the oldest event in place with Front() and frees its slot with Pop().
+   * Before the producer frees or reuses the memory of pushed events, such
+   * as when it releases its ET batch, it calls Detach().  That copies the
+   * events still waiting into memory owned by their slots.  Slots keep
+   * that memory, so once every slot has seen the largest event size no
+   * more allocations happen.
+   * Exactly one thread may push and one other thread may pop.
+   */
+  class EventQueue {
+  public:
+    explicit EventQueue(size_t depth = 1000);
+    virtual ~EventQueue() {}
+
+    // producer side, buf must stay valid until popped or Detach()
+    bool Push(const uint32_t *buf, size_t nwords)
+    {
+      size_t tail = fTail.load(std::memory_order_relaxed);
+      size_t next = (tail + 1) % fSlots.size();
+      if (next == fHead.load(std::memory_order_acquire))
+        return false;  // full
+      Slot &slot = fSlots[tail];
+      slot.nwords = nwords;
+      slot.owned = false;
+      slot.data.store(buf, std::memory_order_relaxed);
+      fTail.store(next, std::memory_order_release);
+      return true;
+    }
+    // producer side, see Detach() in the .cxx
+    size_t Detach(const std::atomic<bool> &running);
+
+    // consumer side, returns nullptr if empty
+    const uint32_t *Front(size_t &nwords) const
+    {
+      size_t head = fHead.load(std::memory_order_relaxed);
+      if (head == fTail.load(std::memory_order_acquire))
+        return nullptr;
+      nwords = fSlots[head].nwords;
+      return fSlots[head].data.load(std::memory_order_acquire);
+    }
+
+    void Pop()
+    {
+      size_t head = fHead.load(std::memory_order_relaxed);
+      fHead.store((head + 1) % fSlots.size(), std::memory_order_release);
+    }
+
+    // approximate when called concurrently
+    size_t Size() const
+    {
+      size_t head = fHead.load(std::memory_order_acquire);
+      size_t tail = fTail.load(std::memory_order_acquire);
+      return (tail + fSlots.size() - head) % fSlots.size();
+    }
+    size_t Capacity() const { return fSlots.size() - 1; }
+
+  private:
+    struct Slot {
+      std::atomic<const uint32_t*> data{nullptr};  // event, in place or copy
+      size_t                       nwords = 0;
+      bool                         owned = false;  // data points to copy
+      std::vector<uint32_t>        copy;           // event copied by Detach()
+    };
+    std::vector<Slot>                  fSlots;
+    std::atomic<size_t>                fHead;  // next slot to read
+    std::atomic<size_t>                fTail;  // next slot to write
+  };
+
+} // namespace hcana
+#endif
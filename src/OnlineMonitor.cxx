@@ -1,8 +1,27 @@
 #include "OnlineMonitor.h"
 #include "PRadETChannel.h"
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TH1.h"
+#include "TTree.h"
+#include <algorithm>
 
 using namespace std::chrono;
 
+// raw event classes seen by the ET reader
+enum { kRawPhysics, kRawControl, kRawOther };
+
+// classify an event from its bank header, CODA 2 or 3
+static int RawEventClass(const uint32_t *buf)
+{
+    uint32_t tag = buf[1] >> 16;
+    if ((tag >= 0xFF50 && tag <= 0xFF8F) || (tag >= 1 && tag < 16))
+        return kRawPhysics;
+    if ((tag >= 0xFFD0 && tag <= 0xFFD4) || (tag >= 16 && tag <= 20))
+        return kRawControl;
+    return kRawOther;
+}
+
 
 namespace hcana {
 
@@ -10,6 +29,17 @@ Int_t OnlineMonitor::Monitor(PRadETChannel *ch, std::chrono::seconds interval)
 {
     Int_t total = 0;
     fMonitor = true;
+    fNQueued = 0;
+    fNWaits = 0;
+    fNCopied = 0;
+    fNAnalyzed = 0;
+    fNSkipped = 0;
+    fSampleLevel = 0;
+    fSampling = 1.;
+    fPrescale = 1;
+    fLastAnalyzed = 0;
+    fNPhysReceived = fNPhysKept = 0;
+    fPublished.clear();
     static const char* const here = "Monitor";
 
     fBench->Begin("Total");
@@ -17,16 +47,41 @@ Int_t OnlineMonitor::Monitor(PRadETChannel *ch, std::chrono::seconds interval)
     void (*prev_handler)(int);
     prev_handler = signal(SIGINT, handle_sig);
 
-    while (!fMonitor) {
-        system_clock::time_point start(system_clock::now());
-        system_clock::time_point next(start + interval);
+    // ET reader -> queue -> analysis (this thread) -> periodic publishing
+    EventQueue queue(fQueueDepth);
+    std::thread reader(&OnlineMonitor::ReadET, this, ch, &queue);
+
+    steady_clock::time_point next_publish(steady_clock::now() + interval);
+    while (fMonitor && !sig_caught) {
+        size_t nwords = 0;
+        const uint32_t *buf = queue.Front(nwords);
+        if (buf) {
+            try {
+                total += ReadBuffer(const_cast<uint32_t*>(buf));
+            }
+            catch (PRadException e) {
+                std::cerr << e.FailureType() << ": " << e.FailureDesc() << std::endl;
+                fMonitor = false;
+            }
+            queue.Pop();
+            fNAnalyzed++;
+        } else {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
 
-        total += ReadOnce(ch);
-        std::this_thread::sleep_until(next);
+        if (steady_clock::now() >= next_publish) {
+            Publish();
+            next_publish = steady_clock::now() + interval;
+        }
     }
+    fMonitor = false;
+    reader.join();
 
     signal(SIGINT, prev_handler);
 
+    _logger->info("{} : {} events analyzed, {} left in queue, sampling fraction {:.3f}",
+                  here, fNAnalyzed.load(), queue.Size(), fSampling.load());
+
     if (fDoBench)
         fBench->Begin("Output");
 
@@ -48,18 +103,175 @@ Int_t OnlineMonitor::Monitor(PRadETChannel *ch, std::chrono::seconds interval)
 }
 
 
+void OnlineMonitor::ReadET(PRadETChannel *ch, EventQueue *queue)
+{
+    // reader thread, only talks to ET and the queue
+    // The events are queued as views into the current ET batch and are
+    // analyzed in place.  The batch goes back to ET when the next one is
+    // read.  The reader waits for the analysis to catch up first, unless a
+    // full batch is already waiting in the station.  Only then are the
+    // queued events that were not analyzed yet copied (EventQueue::Detach).
+    try {
+        steady_clock::time_point last_check(steady_clock::now());
+        PRadETStation *stat = ch->GetCurrentStation();
+
+        while (fMonitor) {
+            while (fMonitor && queue->Size() > 0 &&
+                   !(stat && stat->GetInputCount() >= ET_CHUNK_SIZE))
+                std::this_thread::sleep_for(milliseconds(1));
+            if (!fMonitor)
+                break;
+            fNCopied += queue->Detach(fMonitor);
+            size_t nread = ch->ReadBatch();
+            for (size_t i = 0; i < nread && fMonitor; ++i) {
+                const uint32_t *buf = ch->GetBatchBuffer(i);
+                int evclass = RawEventClass(buf);
+                if (evclass == kRawPhysics) {
+                    // only physics events are sampled
+                    if (++fNPhysReceived % fPrescale != 0) {
+                        fNSkipped++;
+                        continue;
+                    }
+                    fNPhysKept++;
+                }
+                // analysis is behind, hold the ET events until there is room
+                while (!queue->Push(buf, ch->GetBatchLength(i))) {
+                    fNWaits++;
+                    if (!fMonitor)
+                        break;
+                    std::this_thread::sleep_for(microseconds(100));
+                }
+                if (fMonitor)
+                    fNQueued++;
+            }
+            if (nread > 0) {
+                if (fNPhysReceived > 0)
+                    fSampling = double(fNPhysKept)/fNPhysReceived;
+            } else {
+                std::this_thread::sleep_for(milliseconds(1));
+            }
+
+            steady_clock::time_point now(steady_clock::now());
+            double dt = duration<double>(now - last_check).count();
+            if (dt >= 1.) {
+                AdjustSampling(ch, queue, dt);
+                last_check = now;
+            }
+        }
+        // the analysis has stopped, nothing reads the batch any more
+        ch->ReleaseBatch();
+    }
+    catch (PRadException e) {
+        std::cerr << e.FailureType() << ": " << e.FailureDesc() << std::endl;
+        fMonitor = false;
+    }
+}
+
+
+void OnlineMonitor::AdjustSampling(PRadETChannel *ch, const EventQueue *queue, double dt)
+{
+    size_t analyzed = fNAnalyzed;
+    double rate = (analyzed - fLastAnalyzed)/dt;
+    fLastAnalyzed = analyzed;
+
+    if (fLatencyBudget <= 0.)
+        return;
+
+    PRadETStation *stat = ch->GetCurrentStation();
+    size_t backlog = queue->Size() + (stat ? stat->GetInputCount() : 0);
+    double latency = 0.;
+    if (backlog > 0)
+        latency = (rate > 0.) ? backlog/rate : 2.*fLatencyBudget;
+
+    // step up at once, step down only when well below the budget
+    int level = fSampleLevel;
+    if (latency > fLatencyBudget && fPrescale*2 <= fMaxPrescale) {
+        level++;
+    } else if (latency < 0.25*fLatencyBudget && level > 0) {
+        level--;
+    } else {
+        return;
+    }
+    fSampleLevel = level;
+    fPrescale = 1 << level;
+    _logger->info("Monitor: latency {:.2f} s ({} events behind at {:.0f} Hz), "
+                  "sampling level {}, physics prescale {}",
+                  latency, backlog, rate, level, fPrescale);
+}
+
+
+void OnlineMonitor::Publish()
+{
+    // make everything filled so far visible to readers of the output file
+    // Only the trees and histograms that got entries since the last publish
+    // are written.  A histogram replaces its previous cycle once the new one
+    // is written (kWriteDelete), so a reader always finds one.
+    if (fDoBench)
+        fBench->Begin("Output");
+
+    if (fOutput && fOutput->GetTree()) {
+        fFile = fOutput->GetTree()->GetCurrentFile();
+    }
+    if (fFile) {
+        TDirectory::TContext ctx(fFile);
+        size_t nwritten = 0;
+        TIter next(fFile->GetList());
+        while (TObject *obj = next()) {
+            TTree *tree = dynamic_cast<TTree*>(obj);
+            TH1 *hist = tree ? nullptr : dynamic_cast<TH1*>(obj);
+            if (!tree && !hist)
+                continue;
+            double entries = tree ? tree->GetEntries() : hist->GetEntries();
+            auto it = fPublished.find(obj);
+            if (it != fPublished.end() && it->second == entries)
+                continue;
+            fPublished[obj] = entries;
+            if (tree)
+                tree->AutoSave("SaveSelf;FlushBaskets");
+            else
+                hist->Write(nullptr, TObject::kWriteDelete);
+            nwritten++;
+        }
+        fFile->Flush();
+        _logger->debug("Monitor: published {} objects", nwritten);
+    }
+    _logger->info("Monitor: {} events analyzed, {} queued, queue {}/{}, reader waited {} times, "
+                  "{} events copied out of ET",
+                  fNAnalyzed.load(), fNQueued.load(), fNQueued.load() - fNAnalyzed.load(), fQueueDepth,
+                  fNWaits.load(), fNCopied.load());
+    _logger->info("Monitor: sampling fraction {:.3f}, level {}, {} physics events skipped",
+                  fSampling.load(), fSampleLevel.load(), fNSkipped.load());
+
+    if (fDoBench)
+        fBench->Stop("Output");
+}
+
+
 Int_t OnlineMonitor::ReadOnce(PRadETChannel *ch, size_t max_events)
 try {
     Int_t count = 0;
-    for(size_t num = 0; ch->Read() && (num < max_events); ++num) {
-        auto buf = ch->GetBuffer();
-        count += ReadBuffer((uint32_t*)(ch->GetBuffer()));
+    size_t num = 0;
+    while (num < max_events) {
+        // events are analyzed in place in ET memory, then put back together
+        size_t nread = ch->ReadBatch(std::min<size_t>(ET_CHUNK_SIZE, max_events - num));
+        if (nread == 0)
+            break;
+        for (size_t i = 0; i < nread; ++i) {
+            count += ReadBuffer(ch->GetBatchBuffer(i));
+        }
+        ch->ReleaseBatch();
+        num += nread;
     }
     return count;
 }
 catch (PRadException e) {
     std::cerr << e.FailureType() << ": " << e.FailureDesc() << std::endl;
     fMonitor = false;
+    try {
+        ch->ReleaseBatch();
+    } catch (PRadException e2) {
+        std::cerr << e2.FailureType() << ": " << e2.FailureDesc() << std::endl;
+    }
     return 0;
 }
 
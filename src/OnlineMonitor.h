@@ -3,9 +3,12 @@
 
 #include "THaBenchmark.h"
 #include "THcAnalyzer.h"
+#include "EventQueue.h"
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <map>
 
 
 class PRadETChannel;
@@ -17,15 +20,68 @@ namespace hcana {
         OnlineMonitor() : THcAnalyzer() {}
         virtual ~OnlineMonitor() {}
 
+        /** Monitor the ET system until interrupted.
+         * A reader thread takes events from ET and queues them in a
+         * single-producer/single-consumer EventQueue.  The calling thread
+         * analyzes them in place in ET memory as they arrive.  Events are
+         * only copied when the reader has to release its ET batch before
+         * the analysis got to them.  Every interval, the trees and
+         * histograms that changed are written to the output file.
+         * The analysis runs on this one thread: detectors register their
+         * variables in the global gHaVars and gHcParms, so several analysis
+         * workers with their own detectors, and a stage merging their
+         * histograms and scalers, are not implemented.
+         */
         virtual Int_t Monitor(PRadETChannel *ch, std::chrono::seconds interval = std::chrono::seconds(10));
         virtual Int_t ReadOnce(PRadETChannel *ch, size_t max_events = 10000);
         Int_t ReadBuffer(uint32_t *buf);
         Int_t ProcOneEvent();
         //Int_t GoToEndOfCodaFile();
 
+        // number of events that can wait between ET reader and analysis
+        void SetQueueDepth(size_t depth) { fQueueDepth = depth; }
+
+        /** Sampling control, keeps the monitor within a latency budget.
+         * When the backlog (queue + ET station input list) would take longer
+         * than the budget to analyze, the reader prescales physics events,
+         * doubling the prescale step by step up to the maximum.  Control,
+         * scaler, EPICS and other non-physics events are always analyzed.
+         * The prescale is applied here and not by the ET station, since ET
+         * only prescales blocking stations.  A budget of 0 disables the
+         * controller.
+         */
+        void SetLatencyBudget(double seconds) { fLatencyBudget = seconds; }
+        void SetMaxPrescale(int prescale) { fMaxPrescale = prescale; }
+        // fraction of the physics events received from ET that got queued
+        double GetSamplingFraction() const { return fSampling; }
+
         ClassDef(OnlineMonitor, 0) // Hall C Analyzer Standard Event Loop
+    protected:
+        void ReadET(PRadETChannel *ch, EventQueue *queue);
+        void AdjustSampling(PRadETChannel *ch, const EventQueue *queue, double dt);
+        virtual void Publish();
+
     private:
-        bool fMonitor;
+        std::atomic<bool> fMonitor{false};   //!
+        size_t fQueueDepth = 1000;
+        std::atomic<size_t> fNQueued{0};     //! events queued by the reader
+        std::atomic<size_t> fNWaits{0};      //! times the reader found the queue full
+        std::atomic<size_t> fNCopied{0};     //! events copied before an ET release
+        std::atomic<size_t> fNAnalyzed{0};   //!
+
+        // sampling controller, the state is owned by the reader thread
+        double fLatencyBudget = 2.;          // seconds
+        int fMaxPrescale = 64;
+        std::atomic<int> fSampleLevel{0};    //! physics prescale 2^level
+        std::atomic<double> fSampling{1.};   //!
+        std::atomic<size_t> fNSkipped{0};    //! physics events prescaled away
+        int fPrescale = 1;
+        size_t fLastAnalyzed = 0;
+        size_t fNPhysReceived = 0;
+        size_t fNPhysKept = 0;
+
+        // entries of each tree and histogram at its last publish
+        std::map<TObject*, double> fPublished;   //!
     };
 
 } // namespace hcana
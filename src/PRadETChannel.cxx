@@ -19,13 +19,21 @@
 using namespace std;
 
 PRadETChannel::PRadETChannel(size_t size)
-: curr_stat(nullptr), et_id(nullptr), bufferSize(size)
+: curr_stat(nullptr), et_id(nullptr), bufferSize(size), chunkSize(0)
 {
     buffer = new uint32_t[bufferSize];
+    chunkViews.reserve(ET_CHUNK_SIZE);
 }
 
 PRadETChannel::~PRadETChannel()
 {
+    // return held events before closing
+    try {
+        ReleaseBatch();
+    } catch (PRadException e) {
+        cerr << e.FailureType() << ": " << e.FailureDesc() << endl;
+    }
+
     if(buffer != nullptr)
         delete[](buffer), buffer = nullptr;
 
@@ -179,6 +187,77 @@ bool PRadETChannel::Read()
 }
 
 
+// Read up to max_events events from ET station in one call, return the
+// number of events read. The events are not copied, they can be accessed
+// through GetBatchBuffer until ReleaseBatch puts them back to ET
+size_t PRadETChannel::ReadBatch(size_t max_events)
+{
+    // check if et is opened or alive
+    if(et_id == nullptr || !et_alive(et_id))
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: et is not opened or dead!"));
+
+    // events from the last batch must go back first
+    ReleaseBatch();
+
+    if(max_events > ET_CHUNK_SIZE)
+        max_events = ET_CHUNK_SIZE;
+
+    et_att_id att = curr_stat->GetAttachID();
+
+    int nread = 0;
+    int status = et_events_get(et_id, att, etChunk, ET_ASYNC, nullptr, max_events, &nread);
+
+    switch(status)
+    {
+    case ET_OK:
+        break;
+    case ET_ERROR_EMPTY:
+        return 0;
+    case ET_ERROR_DEAD:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: et is dead!"));
+    case ET_ERROR_TIMEOUT:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: got timeout!!"));
+    case ET_ERROR_BUSY:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: station is busy!"));
+    case ET_ERROR_WAKEUP:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: someone told me to wake up."));
+    default:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: unkown error!"));
+    }
+
+    chunkSize = nread;
+    for(int i = 0; i < chunkSize; ++i)
+        chunkViews.push_back(viewEvent(etChunk[i]));
+
+    return chunkViews.size();
+}
+
+// Put all events of the current batch back to ET
+void PRadETChannel::ReleaseBatch()
+{
+    if(chunkSize == 0)
+        return;
+
+    chunkViews.clear();
+    int num = chunkSize;
+    chunkSize = 0;
+
+    if(et_id == nullptr || !et_alive(et_id))
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: et is not opened or dead!"));
+
+    int status = et_events_put(et_id, curr_stat->GetAttachID(), etChunk, num);
+
+    switch(status)
+    {
+    case ET_OK:
+        break;
+    case ET_ERROR_DEAD:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: et is dead!"));
+    default:
+        throw(PRadException(PRadException::ET_READ_ERROR,"et_client: unkown error!"));
+    }
+}
+
 bool PRadETChannel::Write(void *buf, int nbytes)
 {
     // check if et is opened or alive
@@ -250,6 +329,26 @@ void PRadETChannel::copyEvent()
 }
 
 
+PRadETChannel::EventView PRadETChannel::viewEvent(et_event *ev)
+{
+    void *data;
+    size_t length;
+    et_event_getdata(ev, &data);
+    et_event_getlength(ev, &length);
+    length /= 4; // from byte to int32 words
+
+    EventView view;
+    view.data = (uint32_t*) data;
+    view.length = length;
+    // check if it is a block header
+    if(length >= 8 && view.data[7] == 0xc0da0100) {
+        view.data += 8;
+        view.length -= 8;
+    }
+    return view;
+}
+
+
 // nested config classes
 // et_openconfig
 PRadETChannel::Configuration::Configuration()
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
 #include <stdint.h>
 #include "et.h"
 #include "PRadException.h"
@@ -57,6 +58,12 @@ public:
     void DetachStation();
     void ForceClose();
     bool Read();
+    // batched reading, events stay in ET memory until ReleaseBatch()
+    size_t ReadBatch(size_t max_events = ET_CHUNK_SIZE);
+    size_t GetBatchSize() const {return chunkViews.size();}
+    uint32_t *GetBatchBuffer(size_t i) const {return chunkViews[i].data;}
+    size_t GetBatchLength(size_t i) const {return chunkViews[i].length;}
+    void ReleaseBatch();
     bool Write(void *buf, int nbytes);
     void *GetBuffer() {return (void*) buffer;}
     size_t GetBufferLength() {return bufferSize;}
@@ -74,6 +81,17 @@ private:
     uint32_t *buffer;
     size_t bufferSize;
     void copyEvent();
+
+    // a view of one event in ET memory, block header skipped
+    struct EventView
+    {
+        uint32_t *data;
+        size_t length;
+    };
+    et_event *etChunk[ET_CHUNK_SIZE];
+    int chunkSize;
+    std::vector<EventView> chunkViews;
+    EventView viewEvent(et_event *ev);
 };
 
 #endif
@@ -114,6 +114,16 @@ void PRadETStation::Remove()
     }
 }
 
+// number of events waiting in the station input list
+int PRadETStation::GetInputCount()
+{
+    int val = 0;
+    if(et_station_getinputcount(et_system->GetID(), station_id, &val) < ET_OK) {
+        throw(PRadException(PRadException::ET_STATION_CONFIG_ERROR, "et_client: error in getting station input count!"));
+    }
+    return val;
+}
+
 
 // et_station_config
 PRadETStation::Configuration::Configuration()
@@ -49,6 +49,9 @@ public:
     void Detach();
     void Remove();
 
+    // number of events waiting in the station input list
+    int GetInputCount();
+
 private:
     PRadETChannel *et_system;
     std::string name;
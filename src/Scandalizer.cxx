@@ -1,5 +1,24 @@
 #include "Scandalizer.h"
 #include "THaRun.h"
+#include "THcMmapRun.h"
+#include "THcRNTupleOutput.h"
+#include "THcGlobals.h"
+#include "THcParmList.h"
+#include "THaVarList.h"
+#include "THaVar.h"
+#include "TFileMerger.h"
+#include "TKey.h"
+#include "TH1.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace std;
 
@@ -24,16 +43,30 @@ Int_t Scandalizer::ReadOneEvent()
   while(_skip_events > 0  ) {
     _logger->debug("non-zero skip_events: {}", _skip_events);
     int skipped = 0;
+    auto mrun = dynamic_cast<THcMmapRun*>(fRun);
     auto run =  dynamic_cast<THaRun*>(fRun);
-    if( run ) {
+    if( mrun ) {
+      skipped = mrun->SkipEvents(_skip_events);
+    } else if( run ) {
       skipped = run->SkipToEndOfFile(_skip_events);
     }
     _skip_events = 0;
     _logger->info("skipped {} events", skipped);
+    // The index only covers complete passes through the file
+    delete fNewIndex;
+    fNewIndex = nullptr;
     continue;
   }
+  if( to_read_file && fSeekNext < fSeekPlan.size() && !SeekSlice() ) {
+    if( fDoBench ) {fBench->Stop("RawDecode");}
+    return THaRunBase::READ_FATAL;
+  }
+  if( (_seek_event >= 0 || _seek_evtype >= 0) && SeekEvent() ) {
+    to_read_file = true;
+  }
+  const UInt_t* evbuffer = nullptr;
   if (to_read_file){
-    status = fRun->ReadEvent();
+    status = ReadRawEvent(evbuffer);
   }
 
   // there may be a better place to do this, but this works
@@ -47,7 +80,7 @@ Int_t Scandalizer::ReadOneEvent()
     case THaRunBase::READ_OK:
       // Decode the event
       if (to_read_file) {
-        status = fEvData->LoadEvent( fRun->GetEvBuffer() );
+        status = fEvData->LoadEvent( evbuffer );
       } else {
         status = fEvData->LoadFromMultiBlock( );  // load next event in block
       }
@@ -56,6 +89,13 @@ Int_t Scandalizer::ReadOneEvent()
           //std::cout << "HED_WARN\n";
         case THaEvData::HED_OK:     // fall through
           status = THaRunBase::READ_OK;
+          // After a seek, move on to the requested event of the block
+          while( fSkipInBlock > 0 && fEvData->IsMultiBlockMode() &&
+                 !fEvData->BlockIsDone() &&
+                 fEvData->LoadFromMultiBlock() == THaEvData::HED_OK ) {
+            fSkipInBlock--;
+          }
+          fSkipInBlock = 0;
           Incr(kNevRead);
           break;
         case THaEvData::HED_ERR:
@@ -83,6 +123,188 @@ Int_t Scandalizer::ReadOneEvent()
   return status;
 }
 
+Int_t Scandalizer::ReadRawEvent(const UInt_t*& evbuffer)
+{
+  // Get the next raw event buffer of the run, from the read-ahead ring if
+  // prefetching is enabled.  The prefetcher is started on first use, after
+  // any requested events have been skipped.
+
+  // A mapped run hands out events in place; copying them would only
+  // cost time
+  THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(fRun);
+  if( fPrefetchDepth > 0 && !(mrun && mrun->IsMapped()) ) {
+    if( !fPrefetch ) {
+      fPrefetch = new EventPrefetcher(fRun, fPrefetchDepth);
+      fPrefetch->Start();
+    }
+    return fPrefetch->Next(evbuffer);
+  }
+  Int_t status = fRun->ReadEvent();
+  evbuffer = fRun->GetEvBuffer();
+  if( fNewIndex && status == THaRunBase::READ_OK && mrun ) {
+    fNewIndex->AddEvent(evbuffer, mrun->GetEventOffset(), mrun->GetEventBlock(),
+                        mrun->GetEvioVersion());
+  }
+  return status;
+}
+
+Bool_t Scandalizer::SeekEvent()
+{
+  // Carry out a requested seek to event _seek_event or to the next event
+  // of type _seek_evtype.  Returns true if the run was repositioned.
+
+  Bool_t ok = false;
+  THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(fRun);
+  if( !mrun || !mrun->IsMapped() || fPrefetch ) {
+    _logger->warn("Seeking needs a memory-mapped THcMmapRun");
+  } else if( _seek_event >= 0 ) {
+    Int_t inblock = mrun->SeekToEvent(_seek_event);
+    if( inblock >= 0 ) {
+      fSkipInBlock = inblock;
+      ok = true;
+      _logger->info("seek to event {}", _seek_event);
+    } else {
+      _logger->warn("event {} not found in event index", _seek_event);
+    }
+  } else {
+    ok = (mrun->SeekToEventType(_seek_evtype) == 0);
+    if( ok ) {
+      _logger->info("seek to next event of type {}", _seek_evtype);
+    } else {
+      _logger->warn("no event of type {} found in event index", _seek_evtype);
+    }
+  }
+  _seek_event = -1;
+  _seek_evtype = -1;
+  if( ok ) {
+    delete fNewIndex;
+    fNewIndex = nullptr;
+  }
+  return ok;
+}
+
+Bool_t Scandalizer::PlanSliceSeek()
+{
+  // Plan the seeks that take an event-parallel worker to the start of its
+  // slice with the event index of the run: every barrier event before the
+  // slice, then the event holding the first physics event of the slice.
+  // Returns false if the worker has to decode its way to the slice.
+
+  fSeekPlan.clear();
+  fSeekNext = 0;
+  fSliceSkip = 0;
+  if( fWorkerID < 0 || fCountOnly || fSliceFirst <= 1 ||
+      fCountMode != kCountPhysics || _skip_events > 0 ||
+      _seek_event >= 0 || _seek_evtype >= 0 ) {
+    return false;
+  }
+  THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(fRun);
+  if( !mrun || !mrun->IsMapped() || mrun->LoadIndex() != 0 ) {
+    _logger->info("Scandalizer: no event index, worker {} decodes up to event {}",
+                  fWorkerID, fSliceFirst);
+    return false;
+  }
+  const THcEventIndex* index = mrun->GetIndex();
+  ULong64_t nbefore = 0;
+  for( size_t i = 0; i < index->GetSize(); i++ ) {
+    const THcEventIndex::Entry& e = index->GetEntry(i);
+    if( e.nevents == 0 ) {
+      fSeekPlan.push_back(i);
+      continue;
+    }
+    if( nbefore + e.nevents >= fSliceFirst ) {
+      fSeekPlan.push_back(i);
+      fSliceSkip = fSliceFirst - 1 - nbefore;
+      _logger->info("Scandalizer: worker {} seeks to event {} through {} barrier events",
+                    fWorkerID, fSliceFirst, fSeekPlan.size()-1);
+      return true;
+    }
+    nbefore += e.nevents;
+  }
+  // The slice starts after the last indexed event
+  fSeekPlan.clear();
+  return false;
+}
+
+Bool_t Scandalizer::SeekSlice()
+{
+  // Go to the next event of the seek plan.  The last one holds the first
+  // physics event of the slice.
+
+  THcMmapRun* mrun = static_cast<THcMmapRun*>(fRun);
+  const THcEventIndex::Entry& e = mrun->GetIndex()->GetEntry(fSeekPlan[fSeekNext++]);
+  if( mrun->SeekTo(e.offset, e.block) != 0 ) {
+    _logger->error("Scandalizer: worker {} cannot seek to word {}", fWorkerID, e.offset);
+    fSeekPlan.clear();
+    return false;
+  }
+  if( fSeekNext == fSeekPlan.size() ) {
+    fSkipInBlock = fSliceSkip;
+    fNev = fSliceFirst - 1;
+    fSeekPlan.clear();
+    fSeekNext = 0;
+  }
+  return true;
+}
+
+void Scandalizer::StartEventIndex()
+{
+  // Start building the event index of a mapped run that has none
+
+  delete fNewIndex;
+  fNewIndex = nullptr;
+  if( !fWriteIndex || (fWorkerID >= 0 && !fCountOnly) ) {
+    return;
+  }
+  THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(fRun);
+  if( mrun && mrun->IsMapped() && mrun->LoadIndex() != 0 ) {
+    fNewIndex = new THcEventIndex;
+  }
+}
+
+void Scandalizer::FinishEventIndex(Int_t status)
+{
+  // Write the event index if the whole run was read
+
+  if( fNewIndex && status == THaRunBase::READ_EOF ) {
+    THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(fRun);
+    const char* rawfile = mrun->GetFilename();
+    TString idxfile = THcEventIndex::IndexFileName(rawfile);
+    if( fNewIndex->Write(idxfile, rawfile) == 0 ) {
+      _logger->info("Wrote event index {} ({} events)", idxfile.Data(), fNewIndex->GetSize());
+    } else {
+      _logger->warn("Cannot write event index {}", idxfile.Data());
+      gSystem->Unlink(idxfile);
+    }
+  }
+  delete fNewIndex;
+  fNewIndex = nullptr;
+}
+
+void Scandalizer::StartOutputThreads()
+{
+  // Turn on parallel basket compression for the output tree.  Called after
+  // Init, so that the threads are started in the process that writes the
+  // tree and not before fork() in an event-parallel replay.
+  if( fOutputThreads <= 0 || !fOutput || !fOutput->GetTree() )
+    return;
+  if( !ROOT::IsImplicitMTEnabled() )
+    ROOT::EnableImplicitMT(fOutputThreads);
+  // The tree was created before implicit MT was on, so it has it disabled
+  fOutput->GetTree()->SetImplicitMT(true);
+  _logger->info("Scandalizer : compressing output baskets with {} threads",
+                fOutputThreads);
+}
+
+void Scandalizer::StopPrefetch()
+{
+  if( fPrefetch ) {
+    fPrefetch->Stop();
+    delete fPrefetch;
+    fPrefetch = nullptr;
+  }
+}
+
 Int_t Scandalizer::Process( THaRunBase* run )
 {
   // Process the given run. Loop over all events in the event range and
@@ -101,6 +323,10 @@ Int_t Scandalizer::Process( THaRunBase* run )
     }
   }
 
+  if( fNWorkers > 1 && fWorkerID < 0 ) {
+    return ProcessParallel(run);
+  }
+
   //--- Initialization. Creates fFile, fOutput, and fEvent if necessary.
   //    Also copies run to fRun if run is different from fRun
   Int_t status = Init( run );
@@ -111,6 +337,8 @@ Int_t Scandalizer::Process( THaRunBase* run )
   // Restart "Total" since it is stopped in Init()
   fBench->Begin("Total");
 
+  StartOutputThreads();
+
   //--- Re-open the data source. Should succeed since this was tested in Init().
   if( (status = fRun->Open()) != THaRunBase::READ_OK ) {
     Error( here, "Failed to re-open the input file. "
@@ -123,6 +351,8 @@ Int_t Scandalizer::Process( THaRunBase* run )
   // needed by some modules
   gHaRun = fRun;
 
+  StartEventIndex();
+
   // Enable/disable helicity decoding as requested
   fEvData->EnableHelicity( HelicityEnabled() );
   // Set decoder reporting level. FIXME: update when THaEvData is updated
@@ -141,7 +371,9 @@ Int_t Scandalizer::Process( THaRunBase* run )
   //--- The main event loop.
 
   fNev = 0;
-  bool terminate = false, fatal = false;
+  fSliceStart.clear();
+  PlanSliceSeek();
+  bool terminate = false, fatal = false, inslice = false;
   UInt_t nlast = fRun->GetLastEvent();
   fAnalysisStarted = kTRUE;
   BeginAnalysis();
@@ -181,19 +413,27 @@ Int_t Scandalizer::Process( THaRunBase* run )
     // Count events according to the requested mode
     // Whether or not to ignore events prior to fRun->GetFirstEvent()
     // is up to the analysis routines.
-    switch (fCountMode) {
-    case kCountPhysics:
-      if (fEvData->IsPhysicsTrigger())
-        fNev++;
-      break;
-    case kCountAll:
-      fNev++;
-      break;
-    case kCountRaw:
-      fNev = evnum;
-      break;
-    default:
-      break;
+    CountEvent(evnum);
+    if( fCountOnly ) {
+      continue;
+    }
+
+    // An event-parallel worker only analyzes the physics events of its
+    // slice.  All other events are analyzed by every worker.
+    if( fWorkerID >= 0 && fEvData->IsPhysicsTrigger() ) {
+      if( fNev < fSliceFirst ) {
+        continue;
+      }
+      if( fNev > fSliceLast ) {
+        break;
+      }
+      if( !inslice ) {
+        // Everything up to here is reported by the previous worker
+        inslice = true;
+        if( fWorkerID > 0 ) {
+          GetReportValues(fSliceStart, nullptr);
+        }
+      }
     }
 
     //--- Print marks periodically
@@ -240,11 +480,20 @@ Int_t Scandalizer::Process( THaRunBase* run )
 
   }  // End of event loop
 
+  // A worker whose slice is empty (fewer physics events than workers, or
+  // an event limit) reports nothing: everything it read is reported by the
+  // previous workers.
+  if( fWorkerID > 0 && !inslice ) {
+    GetReportValues(fSliceStart, nullptr);
+  }
+
   // restore the previous signal handler
   signal (SIGINT, prev_handler);
   EndAnalysis();
 
   //--- Close the input file
+  StopPrefetch();
+  FinishEventIndex(status);
   fRun->Close();
 
   // Save final run parameters in run object of caller, if any
@@ -322,4 +571,478 @@ Int_t Scandalizer::Process( THaRunBase* run )
   return fNev;
 }
 
+void Scandalizer::CountEvent(UInt_t evnum)
+{
+  switch (fCountMode) {
+  case kCountPhysics:
+    if (fEvData->IsPhysicsTrigger())
+      fNev++;
+    break;
+  case kCountAll:
+    fNev++;
+    break;
+  case kCountRaw:
+    fNev = evnum;
+    break;
+  default:
+    break;
+  }
+}
+
+static TString WorkerFileName(const TString& outfile, Int_t worker)
+{
+  // out.root -> out_w3.root
+  TString name(outfile);
+  if( name.EndsWith(".root") ) {
+    name.Remove(name.Length()-5);
+  }
+  name += TString::Format("_w%d.root", worker);
+  return name;
+}
+
+static void WriteValues(ostringstream& os, char kind, const map<string, vector<Double_t>>& values)
+{
+  // One "kind name n value..." line per report value
+  os.precision(17);
+  for( const auto& v : values ) {
+    os << kind << " " << v.first << " " << v.second.size();
+    for( Double_t x : v.second ) {
+      os << " " << x;
+    }
+    os << "\n";
+  }
+}
+
+static Bool_t WriteAll(int fd, const string& buf)
+{
+  size_t done = 0;
+  while( done < buf.size() ) {
+    ssize_t n = write(fd, buf.data()+done, buf.size()-done);
+    if( n < 0 && errno == EINTR ) {
+      continue;
+    }
+    if( n <= 0 ) {
+      return kFALSE;
+    }
+    done += n;
+  }
+  return kTRUE;
+}
+
+void Scandalizer::GetReportValues(ReportValues& sums, ReportValues* last) const
+{
+  // Collect the values that go into the run report.  Event counts go into
+  // sums: the analyzer counters, the cut statistics and the integer
+  // parameters made after the fork, such as detector statistics.  The other
+  // parameters and the global variables made after the fork go into last,
+  // if given.
+
+  sums.clear();
+  if( last ) {
+    last->clear();
+  }
+  for( size_t i = 0; i < fCounters.size(); i++ ) {
+    sums[Form("#%u", static_cast<UInt_t>(i))].assign(1, fCounters[i].count);
+  }
+  TIter nextcut( gHaCuts->GetCutList() );
+  while( THaCut* cut = static_cast<THaCut*>(nextcut()) ) {
+    string name = cut->GetName();
+    sums[name+".npassed"].assign(1, cut->GetNPassed());
+    sums[name+".scaler"].assign(1, cut->GetNPassed());
+    sums[name+".ncalled"].assign(1, cut->GetNCalled());
+  }
+  Int_t i = 0;
+  TIter nextparm( gHcParms );
+  while( THaVar* var = static_cast<THaVar*>(nextparm()) ) {
+    if( i++ < fNForkParms || !var->IsBasic() || var->GetLen() <= 0 ) {
+      continue;
+    }
+    VarType ty = var->GetType();
+    Bool_t count = ( ty == kInt || ty == kUInt || ty == kLong || ty == kULong ||
+                     ty == kShort || ty == kUShort );
+    if( !count && !last ) {
+      continue;
+    }
+    vector<Double_t>& v = count ? sums[var->GetName()] : (*last)[var->GetName()];
+    v.resize(var->GetLen());
+    for( size_t j = 0; j < v.size(); j++ ) {
+      v[j] = var->GetValue(j);
+    }
+  }
+  if( !last ) {
+    return;
+  }
+  i = 0;
+  TIter nextvar( gHaVars );
+  while( THaVar* var = static_cast<THaVar*>(nextvar()) ) {
+    if( i++ < fNForkVars || !var->IsBasic() || var->GetLen() <= 0 ) {
+      continue;
+    }
+    vector<Double_t>& v = (*last)[var->GetName()];
+    v.resize(var->GetLen());
+    for( size_t j = 0; j < v.size(); j++ ) {
+      v[j] = var->GetValue(j);
+    }
+  }
+}
+
+void Scandalizer::SetReportValues(const ReportValues& values)
+{
+  // Install report values merged from the workers: "#n" is analyzer
+  // counter n, everything else is defined as a parameter in gHcParms
+  // unless the replay already has a parameter of that name.  A cut
+  // statistic such as "hFoundTrack.npassed" is then found by PrintReport
+  // as a parameter, since the cuts only exist in the workers.
+
+  for( const auto& v : values ) {
+    if( v.second.empty() ) {
+      continue;
+    }
+    if( v.first[0] == '#' ) {
+      size_t i = atoi(v.first.c_str()+1);
+      if( i < fCounters.size() ) {
+        fCounters[i].count = static_cast<UInt_t>(v.second[0]);
+      }
+      continue;
+    }
+    auto it = fMerged.find(v.first);
+    if( it != fMerged.end() ) {
+      if( it->second.size() == v.second.size() ) {
+        copy(v.second.begin(), v.second.end(), it->second.begin());
+        continue;
+      }
+      gHcParms->RemoveName(v.first.c_str());
+      fMerged.erase(it);
+    } else if( gHcParms->Find(v.first.c_str()) ) {
+      continue;
+    }
+    vector<Double_t>& store = fMerged[v.first] = v.second;
+    TString name = v.first.c_str();
+    if( store.size() > 1 ) {
+      name += TString::Format("[%u]", static_cast<UInt_t>(store.size()));
+    }
+    gHcParms->Define(name, "Merged from event-parallel workers", store[0]);
+  }
+}
+
+void Scandalizer::LoadRunData(THaRunBase* run)
+{
+  // Copy the final run parameters from the merged output into run and fRun,
+  // as Process does.  PrintReport takes the run number etc. from fRun.
+
+  TFile* file = TFile::Open(fOutFileName, "READ");
+  THaRunBase* rundata = nullptr;
+  if( file && !file->IsZombie() ) {
+    rundata = dynamic_cast<THaRunBase*>(file->Get("Run_Data"));
+  }
+  delete file;
+  if( !rundata ) {
+    _logger->warn("Scandalizer: no run data in {}", fOutFileName.Data());
+    return;
+  }
+  *run = *rundata;
+  if( fRun != run ) {
+    delete fRun;
+    fRun = rundata;
+  } else {
+    delete rundata;
+  }
+}
+
+Int_t Scandalizer::ForkWorker(THaRunBase* run, Int_t worker, const TString& outfile,
+                              int& readfd)
+{
+  // Start a worker process that runs the serial event loop on run.  The
+  // worker reports its final event count and its report values through a
+  // pipe.  The event counts are those of its slice only, so that they add
+  // up to the counts of a serial replay.
+
+  int fds[2];
+  if( pipe(fds) != 0 ) {
+    _logger->error("Scandalizer: cannot create pipe for worker {}", worker);
+    return -1;
+  }
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pid = fork();
+  if( pid < 0 ) {
+    _logger->error("Scandalizer: cannot fork worker {}", worker);
+    close(fds[0]);
+    close(fds[1]);
+    return -1;
+  }
+  if( pid == 0 ) {
+    // Worker process.  Never returns.
+    close(fds[0]);
+    fWorkerID = worker;
+    fNForkParms = gHcParms->GetSize();
+    fNForkVars = gHaVars->GetSize();
+    SetOutFile(outfile.Data());
+    Int_t status = Process(run);
+    ostringstream report;
+    report << "N " << fNev << "\n";
+    if( !fCountOnly && status >= 0 ) {
+      ReportValues sums, last;
+      GetReportValues(sums, &last);
+      for( const auto& v : fSliceStart ) {
+        auto it = sums.find(v.first);
+        if( it == sums.end() ) continue;
+        for( size_t i = 0; i < it->second.size() && i < v.second.size(); i++ ) {
+          it->second[i] -= v.second[i];
+        }
+      }
+      WriteValues(report, 'S', sums);
+      WriteValues(report, 'L', last);
+    }
+    if( !WriteAll(fds[1], report.str()) ) {
+      status = -1;
+    }
+    close(fds[1]);
+    fflush(stdout);
+    fflush(stderr);
+    _exit(status < 0 ? 1 : 0);
+  }
+  close(fds[1]);
+  readfd = fds[0];
+  return pid;
+}
+
+UInt_t Scandalizer::CollectWorker(Int_t pid, int readfd, Bool_t& ok,
+                                  ReportValues& sums, ReportValues& last)
+{
+  // Wait for a worker to finish and return its event count.  Its report
+  // values are added to sums, or replace those in last.  Collect the
+  // workers in slice order, so that last ends up with the values of the
+  // last worker.
+
+  string buf;
+  char chunk[4096];
+  for(;;) {
+    ssize_t n = read(readfd, chunk, sizeof(chunk));
+    if( n > 0 ) {
+      buf.append(chunk, n);
+    } else if( n < 0 && errno == EINTR ) {
+      continue;
+    } else {
+      break;
+    }
+  }
+  close(readfd);
+  istringstream is(buf);
+  string kind, name;
+  UInt_t nev = 0;
+  if( !(is >> kind >> nev) || kind != "N" ) {
+    ok = kFALSE;
+  }
+  size_t len;
+  while( is >> kind >> name >> len ) {
+    vector<Double_t> values(len);
+    for( auto& x : values ) {
+      is >> x;
+    }
+    if( kind == "S" ) {
+      vector<Double_t>& sum = sums[name];
+      if( sum.size() < len ) {
+        sum.resize(len);
+      }
+      for( size_t i = 0; i < len; i++ ) {
+        sum[i] += values[i];
+      }
+    } else {
+      last[name].swap(values);
+    }
+  }
+  int wstatus = 0;
+  if( waitpid(pid, &wstatus, 0) != pid || !WIFEXITED(wstatus) ||
+      WEXITSTATUS(wstatus) != 0 ) {
+    ok = kFALSE;
+  }
+  return nev;
+}
+
+Int_t Scandalizer::ProcessParallel(THaRunBase* run)
+{
+  // Event-parallel replay of run with fNWorkers worker processes.
+  //
+  // The counted events [first, last] of the run are split into fNWorkers
+  // contiguous slices.  If no last event is set, the events are counted
+  // first in a separate pass.  Worker k writes its own output file and
+  // stops after its slice; the last worker reads to the end of the run so
+  // it sees every barrier event.  The worker files are then merged into
+  // the requested output file.  The analyzer counters, cut statistics and
+  // integer parameters are summed over the slices; the other parameters,
+  // the global variables and the run data are those of the last worker.
+  // Floating-point results of the workers' End, such as efficiencies, are
+  // thus those of the last slice only.
+
+  static const char* const here = "Scandalizer::ProcessParallel";
+
+  if( fOutFileName.IsNull() ) {
+    Error( here, "Must specify an output file. Set it with SetOutFile()." );
+    return -30;
+  }
+  TString outfile = fOutFileName;
+  fBench->Begin("Total");
+
+  UInt_t first = TMath::Max(run->GetFirstEvent(), 1u);
+  UInt_t last = run->GetLastEvent();
+  THcMmapRun* mrun = dynamic_cast<THcMmapRun*>(run);
+  if( last == kMaxUInt && mrun && fCountMode == kCountPhysics &&
+      mrun->LoadIndex() == 0 ) {
+    last = mrun->GetIndex()->GetNPhysics();
+    _logger->info("{} : {} physics events in event index", here, last);
+  }
+  if( last == kMaxUInt ) {
+    _logger->info("{} : counting events", here);
+    TString countfile = WorkerFileName(outfile, fNWorkers);
+    int fd = -1;
+    fCountOnly = true;
+    Int_t pid = ForkWorker(run, 0, countfile, fd);
+    fCountOnly = false;
+    Bool_t ok = kTRUE;
+    if( pid > 0 ) {
+      ReportValues sums, lastvalues;
+      last = CollectWorker(pid, fd, ok, sums, lastvalues);
+    } else {
+      ok = kFALSE;
+    }
+    gSystem->Unlink(countfile);
+    if( !ok ) {
+      Error( here, "Counting events failed." );
+      fBench->Stop("Total");
+      return -1;
+    }
+  }
+  if( last < first ) {
+    last = first;
+  }
+  UInt_t nslice = (last - first) / fNWorkers + 1;
+  _logger->info("{} : {} workers, {} events each", here, fNWorkers, nslice);
+
+  std::vector<TString> files;
+  std::vector<Int_t> pids;
+  std::vector<int> fds;
+  for( Int_t worker = 0; worker < fNWorkers; worker++ ) {
+    fSliceFirst = first + worker*nslice;
+    fSliceLast = (worker == fNWorkers-1) ? run->GetLastEvent()
+      : fSliceFirst + nslice - 1;
+    files.push_back(WorkerFileName(outfile, worker));
+    int fd = -1;
+    Int_t pid = ForkWorker(run, worker, files.back(), fd);
+    if( pid < 0 ) {
+      break;
+    }
+    pids.push_back(pid);
+    fds.push_back(fd);
+  }
+  fSliceFirst = fSliceLast = 0;
+
+  Bool_t ok = (pids.size() == files.size());
+  UInt_t nev = 0;
+  ReportValues sums, lastvalues;
+  for( size_t i = 0; i < pids.size(); i++ ) {
+    nev = TMath::Max(nev, CollectWorker(pids[i], fds[i], ok, sums, lastvalues));
+  }
+  if( !ok ) {
+    Error( here, "Event-parallel replay failed. Worker output files kept." );
+    fBench->Stop("Total");
+    return -1;
+  }
+
+  if( fDoBench ) fBench->Begin("Output");
+  ok = MergeWorkerOutput(files);
+  if( fDoBench ) fBench->Stop("Output");
+  if( ok ) {
+    for( const auto& f : files ) {
+      gSystem->Unlink(f);
+    }
+    LoadRunData(run);
+  } else {
+    Error( here, "Merging worker output into %s failed.", outfile.Data() );
+  }
+
+  // Make the merged statistics available to PrintCounters and PrintReport
+  SetReportValues(sums);
+  SetReportValues(lastvalues);
+  if( fVerbose>0 ) {
+    PrintCounters();
+  }
+  fBench->Stop("Total");
+  if( fVerbose>1 && fDoBench ) {
+    fBench->Print("Total");
+  }
+  fNev = nev;
+  return ok ? static_cast<Int_t>(nev) : -1;
+}
+
+Bool_t Scandalizer::MergeWorkerOutput(const std::vector<TString>& files)
+{
+  // Merge the worker files into fOutFileName.  The event tree and the
+  // histograms are concatenated/added over all workers in slice order.
+  // Everything else (scaler and EPICS trees, run data) is only complete in
+  // the last worker, which saw all barrier events, and is copied from there.
+  // The RNTuple of a THcRNTupleOutput is merged like the event tree.
+
+  const char* treename = "T";  // THaOutput event tree
+  THcRNTupleOutput* ntout = dynamic_cast<THcRNTupleOutput*>(fOutput);
+
+  TFile* lastfile = TFile::Open(files.back(), "READ");
+  if( !lastfile || lastfile->IsZombie() ) {
+    delete lastfile;
+    return kFALSE;
+  }
+  std::set<std::string> lastonly;
+  TString lastnames;
+  TIter nextkey(lastfile->GetListOfKeys());
+  while( TKey* key = static_cast<TKey*>(nextkey()) ) {
+    TClass* cl = TClass::GetClass(key->GetClassName());
+    if( cl && (cl->InheritsFrom(TH1::Class()) ||
+               (cl->InheritsFrom(TTree::Class()) && strcmp(key->GetName(), treename) == 0)) ) {
+      continue;
+    }
+    if( ntout && strcmp(key->GetName(), ntout->GetNTupleName()) == 0 ) {
+      continue;
+    }
+    if( lastonly.insert(key->GetName()).second ) {
+      lastnames += key->GetName();
+      lastnames += " ";
+    }
+  }
+
+  TFileMerger merger(kFALSE);
+  merger.SetPrintLevel(0);
+  Bool_t ok = merger.OutputFile(fOutFileName, "RECREATE");
+  for( const auto& f : files ) {
+    ok = ok && merger.AddFile(f, kFALSE);
+  }
+  if( ok ) {
+    if( !lastonly.empty() ) {
+      merger.AddObjectNames(lastnames);
+    }
+    ok = merger.PartialMerge(TFileMerger::kAll | TFileMerger::kRegular |
+                             TFileMerger::kSkipListed);
+  }
+
+  if( ok && !lastonly.empty() ) {
+    TFile* out = TFile::Open(fOutFileName, "UPDATE");
+    ok = (out && !out->IsZombie());
+    for( const auto& name : lastonly ) {
+      if( !ok ) break;
+      TObject* obj = lastfile->Get(name.c_str());
+      if( !obj ) continue;
+      out->cd();
+      if( TTree* tree = dynamic_cast<TTree*>(obj) ) {
+        TTree* copy = tree->CloneTree(-1, "fast");
+        copy->Write();
+        delete copy;
+      } else {
+        obj->Write(name.c_str());
+      }
+    }
+    delete out;
+  }
+  delete lastfile;
+  return ok;
+}
+
 }
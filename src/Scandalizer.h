@@ -3,7 +3,12 @@
 
 #include "THaBenchmark.h"
 #include "THcAnalyzer.h"
+#include "EventPrefetcher.h"
+#include "THcEventIndex.h"
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 
 namespace hcana {
@@ -11,13 +16,99 @@ namespace hcana {
   class Scandalizer : public THcAnalyzer {
   public:
     Scandalizer() : THcAnalyzer() {}
-    virtual ~Scandalizer() {}
+    virtual ~Scandalizer() { delete fPrefetch; delete fNewIndex; }
 
     virtual Int_t Process(THaRunBase* run = nullptr);
     virtual Int_t ReadOneEvent();
     //Int_t GoToEndOfCodaFile();
 
     int _skip_events = 0;
+    // Seek to an event number or to the next event of a type.  Needs a
+    // THcMmapRun with an event index; -1 means no seek.
+    long _seek_event  = -1;
+    int  _seek_evtype = -1;
+
+    /** Write the event index of a THcMmapRun while replaying it, if the run
+     * has none yet.  On by default.
+     */
+    void  SetWriteEventIndex(Bool_t write = true) { fWriteIndex = write; }
+
+    /** Event-parallel replay.
+     * With more than one worker, Process forks one process per worker.  Each
+     * worker owns a complete copy of the analyzer, apparatuses and detectors
+     * and analyzes one contiguous slice of the physics events.  Scaler, EPICS,
+     * config and other non-physics events are barriers: every worker analyzes
+     * all of them up to the end of its slice, so per-run state is the same as
+     * in a serial replay.  With an event index, a worker seeks from barrier
+     * to barrier to the start of its slice instead of decoding up to it.
+     * The worker files are merged in slice order.  The analyzer counters,
+     * cut statistics and the parameters and global variables made by the
+     * workers are merged into this analyzer, so PrintCounters and
+     * PrintReport work after Process as in a serial replay.
+     */
+    void  SetNWorkers(Int_t nworkers) { fNWorkers = nworkers; }
+    Int_t GetNWorkers() const { return fNWorkers; }
+
+    /** Read raw event buffers ahead of the analysis on a background thread,
+     * keeping up to depth buffers ready.  0 (default) reads synchronously.
+     */
+    void  SetPrefetchDepth(Int_t depth) { fPrefetchDepth = depth; }
+    Int_t GetPrefetchDepth() const { return fPrefetchDepth; }
+
+    /** Compress the baskets of the output tree on a pool of nthreads ROOT
+     * implicit MT threads.  The baskets of all branches are then compressed
+     * in parallel at each cluster flush instead of one after the other on
+     * the event loop thread.  0 (default) compresses serially.
+     */
+    void  SetOutputThreads(Int_t nthreads) { fOutputThreads = nthreads; }
+    Int_t GetOutputThreads() const { return fOutputThreads; }
+
+  protected:
+    // Report values by name: counters, cut statistics, parameters, variables
+    typedef std::map<std::string, std::vector<Double_t>> ReportValues;
+
+    virtual Int_t ProcessParallel(THaRunBase* run);
+    Int_t         ForkWorker(THaRunBase* run, Int_t worker, const TString& outfile,
+                             int& readfd);
+    UInt_t        CollectWorker(Int_t pid, int readfd, Bool_t& ok,
+                                ReportValues& sums, ReportValues& last);
+    void          GetReportValues(ReportValues& sums, ReportValues* last) const;
+    void          SetReportValues(const ReportValues& values);
+    void          LoadRunData(THaRunBase* run);
+    Bool_t        PlanSliceSeek();
+    Bool_t        SeekSlice();
+    Bool_t        MergeWorkerOutput(const std::vector<TString>& files);
+    void          CountEvent(UInt_t evnum);
+
+    Int_t  ReadRawEvent(const UInt_t*& evbuffer);
+    void   StopPrefetch();
+    void   StartOutputThreads();
+    Bool_t SeekEvent();
+    void   StartEventIndex();
+    void   FinishEventIndex(Int_t status);
+
+    Int_t  fNWorkers   = 1;
+    Int_t  fWorkerID   = -1;    // Worker number inside a worker process
+    Bool_t fCountOnly  = false; // Only count events, no analysis
+    UInt_t fSliceFirst = 0;     // First counted event analyzed by this worker
+    UInt_t fSliceLast  = 0;     // Last counted event analyzed by this worker
+    Int_t  fNForkParms = 0;     // Size of gHcParms when the worker was forked
+    Int_t  fNForkVars  = 0;     // Size of gHaVars when the worker was forked
+    ReportValues fSliceStart;   //! Summed report values at the start of the slice
+    ReportValues fMerged;       //! Storage of the merged values defined in gHcParms
+
+    std::vector<size_t> fSeekPlan;      // Index entries to seek to, in order
+    size_t              fSeekNext  = 0; // Next entry of fSeekPlan
+    Int_t               fSliceSkip = 0; // Events to skip in the last entry
+
+    Int_t            fPrefetchDepth = 0;
+    EventPrefetcher* fPrefetch = nullptr; //! Read-ahead of the current run
+
+    Int_t  fOutputThreads = 0;
+
+    Bool_t         fWriteIndex  = true;
+    THcEventIndex* fNewIndex    = nullptr; //! Index being built for the current run
+    Int_t          fSkipInBlock = 0;       // Events to skip in the next multi-event block
 
     ClassDef(Scandalizer, 0) // Hall C Analyzer Standard Event Loop
   };
@@ -0,0 +1,146 @@
+/** \class hcana::StageScheduler
+    \ingroup Base
+
+\brief Dependency-ordered execution of reconstruction stages
+
+Used by THcHallCSpectrometer to decode the detectors of several
+spectrometers concurrently and to run their tracking and reconstruction
+stages side by side.  Stages of one Run() are handed out from a ready
+list under one mutex; they are coarse (a detector Decode, a spectrometer
+CoarseTrack), so the lock is not contended.
+
+*/
+#include "StageScheduler.h"
+#include <algorithm>
+
+namespace hcana {
+
+StageScheduler::StageScheduler(unsigned int nworkers)
+{
+  for( unsigned int i = 0; i < nworkers; i++ ) {
+    fWorkers.emplace_back(&StageScheduler::WorkLoop, this);
+  }
+}
+
+StageScheduler::~StageScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fWork.notify_all();
+  for( auto& worker : fWorkers ) {
+    worker.join();
+  }
+}
+
+int StageScheduler::Add(std::function<void()> stage, const std::vector<int>& after)
+{
+  // Add a stage that runs after the stages with the given indices,
+  // which must have been added before.  Returns the index of the stage.
+  int istage = fStages.size();
+  fStages.emplace_back();
+  fStages.back().fn = std::move(stage);
+  for( int iafter : after ) {
+    if( iafter >= 0 && iafter < istage ) {
+      fStages[iafter].next.push_back(istage);
+      fStages.back().nafter++;
+    }
+  }
+  return istage;
+}
+
+void StageScheduler::Clear()
+{
+  fStages.clear();
+}
+
+void StageScheduler::Run()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fReady.clear();
+  fNDone = 0;
+  fError = nullptr;
+  for( size_t i = 0; i < fStages.size(); i++ ) {
+    fStages[i].pending = fStages[i].nafter;
+    fStages[i].skip    = false;
+    if( fStages[i].pending == 0 ) {
+      fReady.push_back(i);
+    }
+  }
+  // Ready stages are taken from the back, start with the first added
+  std::reverse(fReady.begin(), fReady.end());
+  fRunning = true;
+  fWork.notify_all();
+  while( fNDone < fStages.size() ) {
+    if( !RunOne(lock) ) {
+      fDone.wait(lock, [this] { return !fReady.empty() || fNDone == fStages.size(); });
+    }
+  }
+  fRunning = false;
+  if( fError ) {
+    std::exception_ptr error = fError;
+    fError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+bool StageScheduler::RunOne(std::unique_lock<std::mutex>& lock)
+{
+  // Run one ready stage, with the lock released while it runs.
+  // Returns false if no stage was ready.
+  if( fReady.empty() ) {
+    return false;
+  }
+  int istage = fReady.back();
+  fReady.pop_back();
+  Stage& stage = fStages[istage];
+  std::exception_ptr error;
+  if( !stage.skip ) {
+    lock.unlock();
+    try {
+      stage.fn();
+    } catch( ... ) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    if( error && !fError ) {
+      fError = error;
+    }
+  }
+  bool ok = !error;
+  size_t nready = fReady.size();
+  for( int inext : stage.next ) {
+    Stage& next = fStages[inext];
+    if( !ok || stage.skip ) {
+      next.skip = true;
+    }
+    if( --next.pending == 0 ) {
+      fReady.push_back(inext);
+    }
+  }
+  fNDone++;
+  if( fReady.size() > nready + 1 ) {
+    fWork.notify_all();
+  } else if( fReady.size() > nready ) {
+    fWork.notify_one();
+  }
+  if( fNDone == fStages.size() || fReady.size() > nready ) {
+    fDone.notify_all();
+  }
+  return true;
+}
+
+void StageScheduler::WorkLoop()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while( true ) {
+    fWork.wait(lock, [this] { return fStop || (fRunning && !fReady.empty()); });
+    if( fStop ) {
+      break;
+    }
+    RunOne(lock);
+  }
+}
+
+} // namespace hcana
@@ -0,0 +1,61 @@
+#ifndef hcana_StageScheduler_h_
+#define hcana_StageScheduler_h_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hcana {
+
+  /** \brief Runs a graph of reconstruction stages on a thread pool.
+   *
+   * Stages are added with Add(), each with the stages it must wait for,
+   * and Run() executes the graph and returns when every stage is done.
+   * Stages without a path between them may run at the same time.  The
+   * calling thread works on stages too, so a scheduler with no worker
+   * threads runs the stages in the order they were added.  The graph is
+   * kept until Clear(), so the same stages can be run for each event.
+   * If stages throw, Run() rethrows the first exception after the graph
+   * has drained; stages that depend on a failed one are skipped.
+   */
+  class StageScheduler {
+  public:
+    explicit StageScheduler(unsigned int nworkers = 0);
+    virtual ~StageScheduler();
+
+    int  Add(std::function<void()> stage, const std::vector<int>& after = {});
+    void Run();
+    void Clear();
+
+    size_t GetNStages() const { return fStages.size(); }
+    size_t GetNWorkers() const { return fWorkers.size(); }
+
+  private:
+    struct Stage {
+      std::function<void()> fn;
+      std::vector<int>      next;      // Stages waiting for this one
+      int                   nafter = 0;
+      int                   pending;   // Stages still to finish before this one
+      bool                  skip;      // A stage before this one failed
+    };
+
+    void WorkLoop();
+    bool RunOne(std::unique_lock<std::mutex>& lock);
+
+    std::vector<Stage>       fStages;
+    std::vector<int>         fReady;
+    size_t                   fNDone = 0;
+    bool                     fRunning = false;
+    bool                     fStop = false;
+    std::exception_ptr       fError;
+    std::mutex               fMutex;
+    std::condition_variable  fWork;   // Stages ready or stop
+    std::condition_variable  fDone;   // Graph finished
+    std::vector<std::thread> fWorkers;
+  };
+
+} // namespace hcana
+#endif
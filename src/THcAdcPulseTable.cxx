@@ -0,0 +1,105 @@
+/** \class THcAdcPulseTable
+    \ingroup DetSupport
+
+\brief Columnar storage of the FADC pulses of a detector
+
+Filled in the detector's Decode or ProcessHits with one AddPulse per
+pulse, and read back by index in CoarseProcess.  Clear only resets the
+length of the columns, so after the first events no memory is allocated.
+
+*/
+#include "THcAdcPulseTable.h"
+#include "THcRawAdcHit.h"
+#include "THaGlobals.h"
+#include "THaVarList.h"
+#include "TError.h"
+#include "TString.h"
+
+ClassImp(THcAdcPulseTable)
+
+//_____________________________________________________________________________
+void THcAdcPulseTable::Clear()
+{
+  fPaddle.clear();
+  fPedRaw.clear();
+  fPulseIntRaw.clear();
+  fPulseAmpRaw.clear();
+  fPulseTimeRaw.clear();
+  fPed.clear();
+  fPulseInt.clear();
+  fPulseAmp.clear();
+  fPulseTime.clear();
+  fErrorFlag.clear();
+}
+
+//_____________________________________________________________________________
+void THcAdcPulseTable::Reserve(UInt_t npulses)
+{
+  fPaddle.reserve(npulses);
+  fPedRaw.reserve(npulses);
+  fPulseIntRaw.reserve(npulses);
+  fPulseAmpRaw.reserve(npulses);
+  fPulseTimeRaw.reserve(npulses);
+  fPed.reserve(npulses);
+  fPulseInt.reserve(npulses);
+  fPulseAmp.reserve(npulses);
+  fPulseTime.reserve(npulses);
+  fErrorFlag.reserve(npulses);
+}
+
+//_____________________________________________________________________________
+void THcAdcPulseTable::AddPulse(Int_t paddle, THcRawAdcHit& hit, UInt_t ipulse,
+				Double_t timeoffset, Bool_t errorflag)
+{
+  // Add pulse ipulse of hit, with timeoffset added to the pulse time
+  fPaddle.push_back(paddle);
+  fPedRaw.push_back(hit.GetPedRaw());
+  fPulseIntRaw.push_back(hit.GetPulseIntRaw(ipulse));
+  fPulseAmpRaw.push_back(hit.GetPulseAmpRaw(ipulse));
+  fPulseTimeRaw.push_back(hit.GetPulseTimeRaw(ipulse));
+  fPed.push_back(hit.GetPed());
+  fPulseInt.push_back(hit.GetPulseInt(ipulse));
+  fPulseAmp.push_back(hit.GetPulseAmp(ipulse));
+  fPulseTime.push_back(hit.GetPulseTime(ipulse)+timeoffset);
+  fErrorFlag.push_back(errorflag ? 1 : 0);
+}
+
+//_____________________________________________________________________________
+VarDef THcAdcPulseTable::MakeVarDef(EColumn col, const char* name,
+				    const char* desc) const
+{
+  // Variable size global variable pointing at column col
+  VarDef def = { name, desc, kDoubleV, 0, 0, 0 };
+  switch(col) {
+  case kPaddle:       def.type = kIntV; def.loc = &fPaddle; break;
+  case kPedRaw:       def.loc = &fPedRaw;       break;
+  case kPulseIntRaw:  def.loc = &fPulseIntRaw;  break;
+  case kPulseAmpRaw:  def.loc = &fPulseAmpRaw;  break;
+  case kPulseTimeRaw: def.loc = &fPulseTimeRaw; break;
+  case kPed:          def.loc = &fPed;          break;
+  case kPulseInt:     def.loc = &fPulseInt;     break;
+  case kPulseAmp:     def.loc = &fPulseAmp;     break;
+  case kPulseTime:    def.loc = &fPulseTime;    break;
+  case kErrorFlag:    def.loc = &fErrorFlag;    break;
+  }
+  return def;
+}
+
+//_____________________________________________________________________________
+Int_t THcAdcPulseTable::CheckVariables(const VarDef* list, const char* prefix)
+{
+  // Check that every variable of list was defined in gHaVars with the given
+  // prefix.  Returns the number of missing variables.
+  Int_t nmissing = 0;
+  if( !gHaVars )
+    return 0;
+  for( const VarDef* def = list; def->name; def++ ) {
+    TString name = TString(prefix) + def->name;
+    if( !gHaVars->Find(name) ) {
+      ::Error( "THcAdcPulseTable::CheckVariables",
+	       "Global variable %s was not defined", name.Data() );
+      nmissing++;
+    }
+  }
+  return nmissing;
+}
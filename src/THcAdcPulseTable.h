@@ -0,0 +1,72 @@
+#ifndef ROOT_THcAdcPulseTable
+#define ROOT_THcAdcPulseTable
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcAdcPulseTable
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include "VarDef.h"
+#include <vector>
+
+class THcRawAdcHit;
+
+/** \brief Columnar list of the FADC pulses of a detector.
+ *
+ * Replaces the per pulse THcSignalHit TClonesArrays (frAdcPedRaw,
+ * frAdcPulseInt, ..., frAdcErrorFlag).  Row i of every column belongs to
+ * the same pulse.  The columns keep their capacity between events.
+ * They are exported as global variables by address, with the VarDef
+ * entries made by MakeVarDef, since an RVarDef member path can not reach
+ * into a data member of this type.
+ */
+class THcAdcPulseTable {
+
+public:
+  enum EColumn { kPaddle, kPedRaw, kPulseIntRaw, kPulseAmpRaw, kPulseTimeRaw,
+		 kPed, kPulseInt, kPulseAmp, kPulseTime, kErrorFlag };
+
+  THcAdcPulseTable() {}
+  virtual ~THcAdcPulseTable() {}
+
+  void   Clear();
+  void   Reserve(UInt_t npulses);
+
+  void   AddPulse(Int_t paddle, THcRawAdcHit& hit, UInt_t ipulse,
+		  Double_t timeoffset, Bool_t errorflag);
+
+  UInt_t   GetSize() const                { return fPaddle.size(); }
+  Int_t    GetPaddle(UInt_t i) const      { return fPaddle[i]; }
+  Double_t GetPedRaw(UInt_t i) const      { return fPedRaw[i]; }
+  Double_t GetPulseIntRaw(UInt_t i) const { return fPulseIntRaw[i]; }
+  Double_t GetPulseAmpRaw(UInt_t i) const { return fPulseAmpRaw[i]; }
+  Double_t GetPulseTimeRaw(UInt_t i) const { return fPulseTimeRaw[i]; }
+  Double_t GetPed(UInt_t i) const         { return fPed[i]; }
+  Double_t GetPulseInt(UInt_t i) const    { return fPulseInt[i]; }
+  Double_t GetPulseAmp(UInt_t i) const    { return fPulseAmp[i]; }
+  Double_t GetPulseTime(UInt_t i) const   { return fPulseTime[i]; }
+  Bool_t   GetErrorFlag(UInt_t i) const   { return fErrorFlag[i] != 0; }
+
+  // Global variable definition of a column, for DefineVarsFromList
+  VarDef   MakeVarDef(EColumn col, const char* name, const char* desc) const;
+  // Report the variables of list that are missing from gHaVars
+  static Int_t CheckVariables(const VarDef* list, const char* prefix);
+
+protected:
+  std::vector<Int_t>    fPaddle;	// Counter number, from 1
+  std::vector<Double_t> fPedRaw;
+  std::vector<Double_t> fPulseIntRaw;
+  std::vector<Double_t> fPulseAmpRaw;
+  std::vector<Double_t> fPulseTimeRaw;
+  std::vector<Double_t> fPed;
+  std::vector<Double_t> fPulseInt;
+  std::vector<Double_t> fPulseAmp;
+  std::vector<Double_t> fPulseTime;	// Including the ADC-TDC offset
+  std::vector<Double_t> fErrorFlag;	// 1 when the FPGA failed
+
+  ClassDef(THcAdcPulseTable,0)	// Columnar list of FADC pulses
+};
+
+#endif
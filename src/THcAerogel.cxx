@@ -40,13 +40,7 @@ THcAerogel::THcAerogel( const char* name, const char* description,
   fPresentP(0),
   fAdcPosTimeWindowMin(0), fAdcPosTimeWindowMax(0), fAdcNegTimeWindowMin(0),
   fAdcNegTimeWindowMax(0), fRegionValue(0), fPosGain(0), fNegGain(0),
-  frPosAdcPedRaw(0), frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosAdcPed(0), frPosAdcPulseInt(0),
-  frPosAdcPulseAmp(0), frPosAdcPulseTime(0), frNegAdcPedRaw(0),
-  frNegAdcPulseIntRaw(0), frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosAdcErrorFlag(0),
-  fNegAdcErrorFlag(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
+  fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
   fPosPedCount(0), fNegPedSum(0), fNegPedSum2(0), fNegPedLimit(0), fNegPedCount(0),
   fA_Pos(0), fA_Neg(0), fA_Pos_p(0), fA_Neg_p(0), fT_Pos(0), fT_Neg(0),
   fPosPed(0), fPosSig(0), fPosThresh(0), fNegPed(0), fNegSig(0),
@@ -60,13 +54,7 @@ THcAerogel::THcAerogel( ) :
   THaNonTrackingDetector(),
   fAdcPosTimeWindowMin(0), fAdcPosTimeWindowMax(0), fAdcNegTimeWindowMin(0),
   fAdcNegTimeWindowMax(0), fRegionValue(0), fPosGain(0), fNegGain(0),
-  frPosAdcPedRaw(0), frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosAdcPed(0), frPosAdcPulseInt(0),
-  frPosAdcPulseAmp(0), frPosAdcPulseTime(0), frNegAdcPedRaw(0),
-  frNegAdcPulseIntRaw(0), frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosAdcErrorFlag(0),
-  fNegAdcErrorFlag(0), fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
+  fPosPedSum(0), fPosPedSum2(0), fPosPedLimit(0),
   fPosPedCount(0), fNegPedSum(0), fNegPedSum2(0), fNegPedLimit(0), fNegPedCount(0),
   fA_Pos(0), fA_Neg(0), fA_Pos_p(0), fA_Neg_p(0), fT_Pos(0), fT_Neg(0),
   fPosPed(0), fPosSig(0), fPosThresh(0), fNegPed(0), fNegSig(0),
@@ -87,25 +75,6 @@ void THcAerogel::DeleteArrays()
 {
   // Delete all dynamically allocated memory
 
-  delete frPosAdcPedRaw;       frPosAdcPedRaw       = NULL;
-  delete frPosAdcPulseIntRaw;  frPosAdcPulseIntRaw  = NULL;
-  delete frPosAdcPulseAmpRaw;  frPosAdcPulseAmpRaw  = NULL;
-  delete frPosAdcPulseTimeRaw; frPosAdcPulseTimeRaw = NULL;
-  delete frPosAdcPed;          frPosAdcPed          = NULL;
-  delete frPosAdcPulseInt;     frPosAdcPulseInt     = NULL;
-  delete frPosAdcPulseAmp;     frPosAdcPulseAmp     = NULL;
-  delete frPosAdcPulseTime;    frPosAdcPulseTime    = NULL;
-  delete frNegAdcPedRaw;       frNegAdcPedRaw       = NULL;
-  delete frNegAdcPulseIntRaw;  frNegAdcPulseIntRaw  = NULL;
-  delete frNegAdcPulseAmpRaw;  frNegAdcPulseAmpRaw  = NULL;
-  delete frNegAdcPulseTimeRaw; frNegAdcPulseTimeRaw = NULL;
-  delete frNegAdcPed;          frNegAdcPed          = NULL;
-  delete frNegAdcPulseInt;     frNegAdcPulseInt     = NULL;
-  delete frNegAdcPulseAmp;     frNegAdcPulseAmp     = NULL;
-  delete frNegAdcPulseTime;    frNegAdcPulseTime    = NULL;
-  delete fPosAdcErrorFlag;     fPosAdcErrorFlag     = NULL;
-  delete fNegAdcErrorFlag;     fNegAdcErrorFlag     = NULL;
-
   delete [] fRegionValue;         fRegionValue = 0;
   delete [] fAdcPosTimeWindowMin; fAdcPosTimeWindowMin = 0;
   delete [] fAdcPosTimeWindowMax; fAdcPosTimeWindowMax = 0;
@@ -237,24 +206,8 @@ Int_t THcAerogel::ReadDatabase( const TDatime& date )
   fT_Neg       = new Float_t[fNelem];
 
   // Normal constructor with name and description
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPed          = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseInt     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseAmp     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frPosAdcPulseTime    = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPed          = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseInt     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseAmp     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  frNegAdcPulseTime    = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  fPosAdcErrorFlag     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
-  fNegAdcErrorFlag     = new TClonesArray("THcSignalHit", fNelem*MaxNumAdcPulse);
+  fPosAdcPulses.Reserve(fNelem*MaxNumAdcPulse);
+  fNegAdcPulses.Reserve(fNelem*MaxNumAdcPulse);
 
   fNumPosAdcHits.assign(fNelem, 0);
   fNumGoodPosAdcHits.assign(fNelem, 0);
@@ -396,27 +349,32 @@ Int_t THcAerogel::DefineVariables( EMode mode )
       {"numNegAdcHits",        "Number of Negative ADC Hits Per PMT",      "fNumNegAdcHits"},        // Aerogel occupancy
       {"totNumNegAdcHits",     "Total Number of Negative ADC Hits",        "fTotNumNegAdcHits"},     // Aerogel multiplicity
       {"totnumAdcHits",       "Total Number of ADC Hits Per PMT",          "fTotNumAdcHits"},        // Aerogel multiplicity
-
-      {"posAdcPedRaw",       "Positive Raw ADC pedestals",        "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "Positive Raw ADC pulse integrals",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "Positive Raw ADC pulse amplitudes", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "Positive Raw ADC pulse times",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
-      {"posAdcPed",          "Positive ADC pedestals",            "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "Positive ADC pulse integrals",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "Positive ADC pulse amplitudes",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "Positive ADC pulse times",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
-
-      {"negAdcPedRaw",       "Negative Raw ADC pedestals",        "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "Negative Raw ADC pulse integrals",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "Negative Raw ADC pulse amplitudes", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "Negative Raw ADC pulse times",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
-      {"negAdcPed",          "Negative ADC pedestals",            "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "Negative ADC pulse integrals",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "Negative ADC pulse amplitudes",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "Negative ADC pulse times",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
       { 0 }
     };
     DefineVarsFromList( vars, mode);
+
+    VarDef pulsevars[] = {
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "posAdcPedRaw", "Positive Raw ADC pedestals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "posAdcPulseIntRaw", "Positive Raw ADC pulse integrals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "posAdcPulseAmpRaw", "Positive Raw ADC pulse amplitudes"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "posAdcPulseTimeRaw", "Positive Raw ADC pulse times"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "posAdcPed", "Positive ADC pedestals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "posAdcPulseInt", "Positive ADC pulse integrals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "posAdcPulseAmp", "Positive ADC pulse amplitudes"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "posAdcPulseTime", "Positive ADC pulse times"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "negAdcPedRaw", "Negative Raw ADC pedestals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "negAdcPulseIntRaw", "Negative Raw ADC pulse integrals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "negAdcPulseAmpRaw", "Negative Raw ADC pulse amplitudes"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "negAdcPulseTimeRaw", "Negative Raw ADC pulse times"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "negAdcPed", "Negative ADC pedestals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "negAdcPulseInt", "Negative ADC pulse integrals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "negAdcPulseAmp", "Negative ADC pulse amplitudes"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "negAdcPulseTime", "Negative ADC pulse times"),
+      { 0 }
+    };
+    DefineVarsFromList( pulsevars, mode );
+    if( mode == kDefine )
+      THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
   } //end debug statement
 
   if (fSixGevData) {
@@ -444,12 +402,18 @@ Int_t THcAerogel::DefineVariables( EMode mode )
     DefineVarsFromList( vars, mode);
   } //end fSixGevData statement
 
-  RVarDef vars[] = {
-    {"posAdcCounter",   "Positive ADC counter numbers",   "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-    {"negAdcCounter",   "Negative ADC counter numbers",   "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-    {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "fPosAdcErrorFlag.THcSignalHit.GetData()"},
-    {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "fNegAdcErrorFlag.THcSignalHit.GetData()"},
+  VarDef pulsevars[] = {
+    fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "posAdcCounter", "Positive ADC counter numbers"),
+    fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "negAdcCounter", "Negative ADC counter numbers"),
+    fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "posAdcErrorFlag", "Error Flag for When FPGA Fails"),
+    fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "negAdcErrorFlag", "Error Flag for When FPGA Fails"),
+    { 0 }
+  };
+  DefineVarsFromList( pulsevars, mode );
+  if( mode == kDefine )
+    THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
 
+  RVarDef vars[] = {
     {"numGoodPosAdcHits",    "Number of Good Positive ADC Hits Per PMT", "fNumGoodPosAdcHits"},    // Aerogel occupancy
     {"numGoodNegAdcHits",    "Number of Good Negative ADC Hits Per PMT", "fNumGoodNegAdcHits"},    // Aerogel occupancy
     {"totNumGoodPosAdcHits", "Total Number of Good Positive ADC Hits",   "fTotNumGoodPosAdcHits"}, // Aerogel multiplicity
@@ -512,26 +476,8 @@ void THcAerogel::Clear(Option_t* opt)
   fPosNpeSum = 0.0;
   fNegNpeSum = 0.0;
 
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
-
-  fPosAdcErrorFlag->Clear();
-  fNegAdcErrorFlag->Clear();
+  fPosAdcPulses.Clear();
+  fNegAdcPulses.Clear();
 
   for (UInt_t ielem = 0; ielem < fNumPosAdcHits.size(); ielem++)
     fNumPosAdcHits.at(ielem) = 0;
@@ -621,8 +567,6 @@ Int_t THcAerogel::Decode( const THaEvData& evdata )
   }
 
   Int_t  ihit         = 0;
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
 
   while(ihit < fNhits) {
     THcAerogelHit* hit          = (THcAerogelHit*) fRawHitList->At(ihit);
@@ -632,44 +576,19 @@ Int_t THcAerogel::Decode( const THaEvData& evdata )
 
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
 
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPed());
+      fPosAdcPulses.AddPulse(npmt, rawPosAdcHit, thit, fAdcTdcOffset,
+			     rawPosAdcHit.GetPulseAmpRaw(thit) <= 0);
 
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(npmt, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(npmt, 0);
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(npmt, 1);
-
-      ++nrPosAdcHits;
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
       fNumPosAdcHits.at(npmt-1) = npmt;
     }
 
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(npmt, rawNegAdcHit.GetPulseTime(thit));
-
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(npmt, 0);
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(npmt, 1);
+      // No ADC-TDC offset for the negative side times
+      fNegAdcPulses.AddPulse(npmt, rawNegAdcHit, thit, 0.0,
+			     rawNegAdcHit.GetPulseAmpRaw(thit) <= 0);
 
-      ++nrNegAdcHits;
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
       fNumNegAdcHits.at(npmt-1) = npmt;
@@ -692,16 +611,16 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
   if( fglHod ) StartTime = fglHod->GetStartTime();
   //cout << " starttime = " << StartTime << endl;
     // Loop over the elements in the TClonesArray
-    for(Int_t ielem = 0; ielem < frPosAdcPulseInt->GetEntries(); ielem++) {
-
-      Int_t    npmt         = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-      Double_t pulsePed     = ((THcSignalHit*) frPosAdcPed->ConstructedAt(ielem))->GetData();
-      Double_t pulseInt     = ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(ielem))->GetData();
-      Double_t pulseIntRaw  = ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-      Double_t pulseAmp     = ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(ielem))->GetData();
-      Double_t pulseTime    = ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(ielem))->GetData();
+    for(Int_t ielem = 0; ielem < (Int_t)fPosAdcPulses.GetSize(); ielem++) {
+
+      Int_t    npmt         = fPosAdcPulses.GetPaddle(ielem) - 1;
+      Double_t pulsePed     = fPosAdcPulses.GetPed(ielem);
+      Double_t pulseInt     = fPosAdcPulses.GetPulseInt(ielem);
+      Double_t pulseIntRaw  = fPosAdcPulses.GetPulseIntRaw(ielem);
+      Double_t pulseAmp     = fPosAdcPulses.GetPulseAmp(ielem);
+      Double_t pulseTime    = fPosAdcPulses.GetPulseTime(ielem);
       Double_t adctdcdiffTime = StartTime-pulseTime;
-      Bool_t   errorFlag    = ((THcSignalHit*) fPosAdcErrorFlag->ConstructedAt(ielem))->GetData();
+      Bool_t   errorFlag    = fPosAdcPulses.GetErrorFlag(ielem);
       ////      Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin && adctdcdiffTime < fAdcTimeWindowMax;
       Bool_t   pulseTimeCut = adctdcdiffTime > fAdcPosTimeWindowMin[npmt] && adctdcdiffTime < fAdcPosTimeWindowMax[npmt];
 
@@ -713,7 +632,7 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
 
      if (!errorFlag && pulseTimeCut) {
     	fGoodPosAdcPed.at(npmt)         = pulsePed;
- 	//	cout << " out = " << npmt << " " <<   frPosAdcPulseInt->GetEntries() << " " <<fGoodPosAdcMult.at(npmt); 
+ 	//	cout << " out = " << npmt << " " <<   (Int_t)fPosAdcPulses.GetSize() << " " <<fGoodPosAdcMult.at(npmt); 
     	fGoodPosAdcPulseInt.at(npmt)    = pulseInt;
     	fGoodPosAdcPulseIntRaw.at(npmt) = pulseIntRaw;
     	fGoodPosAdcPulseAmp.at(npmt)    = pulseAmp;
@@ -730,16 +649,16 @@ Int_t THcAerogel::CoarseProcess( TClonesArray&  ) //tracks
     }
 
     // Loop over the elements in the TClonesArray
-    for(Int_t ielem = 0; ielem < frNegAdcPulseInt->GetEntries(); ielem++) {
-
-      Int_t    npmt         = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-      Double_t pulsePed     = ((THcSignalHit*) frNegAdcPed->ConstructedAt(ielem))->GetData();
-      Double_t pulseInt     = ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(ielem))->GetData();
-      Double_t pulseIntRaw  = ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-      Double_t pulseAmp     = ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(ielem))->GetData();
-      Double_t pulseTime    = ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(ielem))->GetData();
+    for(Int_t ielem = 0; ielem < (Int_t)fNegAdcPulses.GetSize(); ielem++) {
+
+      Int_t    npmt         = fNegAdcPulses.GetPaddle(ielem) - 1;
+      Double_t pulsePed     = fNegAdcPulses.GetPed(ielem);
+      Double_t pulseInt     = fNegAdcPulses.GetPulseInt(ielem);
+      Double_t pulseIntRaw  = fNegAdcPulses.GetPulseIntRaw(ielem);
+      Double_t pulseAmp     = fNegAdcPulses.GetPulseAmp(ielem);
+      Double_t pulseTime    = fNegAdcPulses.GetPulseTime(ielem);
       Double_t adctdcdiffTime = StartTime-pulseTime;
-      Bool_t   errorFlag    = ((THcSignalHit*) fNegAdcErrorFlag->ConstructedAt(ielem))->GetData();
+      Bool_t   errorFlag    = fNegAdcPulses.GetErrorFlag(ielem);
       ////      Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin && adctdcdiffTime < fAdcTimeWindowMax;
       Bool_t   pulseTimeCut = adctdcdiffTime > fAdcNegTimeWindowMin[npmt] && adctdcdiffTime < fAdcNegTimeWindowMax[npmt];
       if (!errorFlag)
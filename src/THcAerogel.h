@@ -11,6 +11,7 @@
 #include "THaNonTrackingDetector.h"
 #include "THcHitList.h"
 #include "THcAerogelHit.h"
+#include "THcAdcPulseTable.h"
 
 #include "hcana/Logger.h"
 
@@ -92,24 +93,8 @@ class THcAerogel : public THaNonTrackingDetector, public THcHitList {
   Double_t  *fPosGain;
   Double_t  *fNegGain;
   // FADC data objects
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
-  TClonesArray* fPosAdcErrorFlag;
-  TClonesArray* fNegAdcErrorFlag;
+  THcAdcPulseTable fPosAdcPulses;  // All positive side FADC pulses of the event
+  THcAdcPulseTable fNegAdcPulses;
   // Individual PMT data objects
   vector<Int_t>    fNumPosAdcHits;
   vector<Int_t>    fNumNegAdcHits;
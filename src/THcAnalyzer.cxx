@@ -26,6 +26,7 @@ Adds the following to the Hall A analyzer base class.
 #include <iomanip>
 #include <cstring>
 #include <iostream>
+#include <map>
 
 using namespace std;
 
@@ -49,6 +50,22 @@ THcAnalyzer::~THcAnalyzer()
 
 }
 
+//_____________________________________________________________________________
+void THcAnalyzer::SetOutput( THaOutput* output )
+{
+  // Use output instead of a plain THaOutput.  Must be called before the
+  // analyzer is initialized.
+  if( fAnalysisStarted ) {
+    Error( "THcAnalyzer::SetOutput", "Cannot change the output module "
+	   "during the analysis." );
+    return;
+  }
+  if( output != fOutput ) {
+    delete fOutput;
+    fOutput = output;
+  }
+}
+
 //_____________________________________________________________________________
 void THcAnalyzer::PrintReport(const char* templatefile, const char* ofile)
 {
@@ -73,6 +90,9 @@ void THcAnalyzer::PrintReport(const char* templatefile, const char* ofile)
 
   LoadInfo();			// Load some run information into gHcParms
 
+  // Each distinct expression is compiled once per report
+  map<string, THcFormula*> formulas;
+
   // In principle, we should allow braces to be escaped.  But for
   // now we won't.  Existing template files don't seem to output
   // any braces
@@ -101,9 +121,10 @@ void THcAnalyzer::PrintReport(const char* templatefile, const char* ofile)
 	if(format.empty()) format = "%s";
 	replacement=Form(format.c_str(),textstring);
       } else {
-	THcFormula* formula = new THcFormula("temp",expression.c_str(),gHcParms,gHaVars,gHaCuts);
+	THcFormula*& formula = formulas[expression];
+	if(!formula)
+	  formula = new THcFormula("temp",expression.c_str(),gHcParms,gHaVars,gHaCuts);
 	Double_t value=formula->Eval();
-	delete formula; formula = 0;
 	// If the value is close to integer and no format is defined
 	// use "%.0f" to print out integer
 	if(format.empty()) {
@@ -126,6 +147,7 @@ void THcAnalyzer::PrintReport(const char* templatefile, const char* ofile)
   }
   ostr.close();
   ifile.close();
+  for(auto& f : formulas) delete f.second;
 
   return;
 }
@@ -53,6 +53,9 @@ public:
 
   void SetPedestalEvtype( Int_t evtype ) { fPedestalEvtype = evtype; }
 
+  // Replace the output module, e.g. by a THcRNTupleOutput.  Takes ownership.
+  void SetOutput( THaOutput* output );
+
   void PrintReport( const char* templatefile, const char* ofile);
 
 protected:
@@ -19,7 +19,6 @@
 #include "THcHitList.h"
 #include "THcHodoscope.h"
 #include "THcParmList.h"
-#include "THcSignalHit.h"
 #include "TMath.h"
 #include "VarDef.h"
 #include "VarType.h"
@@ -44,15 +43,7 @@ using std::setw;
 THcCherenkov::THcCherenkov(const char* name, const char* description, THaApparatus* apparatus)
     : THaNonTrackingDetector(name, description, apparatus) {
   // Normal constructor with name and description
-  frAdcPedRaw       = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseIntRaw  = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseTimeRaw = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPed          = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseInt     = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseAmp     = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  frAdcPulseTime    = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
-  fAdcErrorFlag     = new TClonesArray("THcSignalHit", MaxNumCerPmt * MaxNumAdcPulse);
+  fAdcPulses.Reserve(MaxNumCerPmt * MaxNumAdcPulse);
 
   fNumAdcHits         = vector<Int_t>(MaxNumCerPmt, 0.0);
   fNumGoodAdcHits     = vector<Int_t>(MaxNumCerPmt, 0.0);
@@ -74,41 +65,12 @@ THcCherenkov::THcCherenkov(const char* name, const char* description, THaApparat
 //_____________________________________________________________________________
 THcCherenkov::THcCherenkov() {
   // Constructor
-  frAdcPedRaw       = NULL;
-  frAdcPulseIntRaw  = NULL;
-  frAdcPulseAmpRaw  = NULL;
-  frAdcPulseTimeRaw = NULL;
-  frAdcPed          = NULL;
-  frAdcPulseInt     = NULL;
-  frAdcPulseAmp     = NULL;
-  frAdcPulseTime    = NULL;
-  fAdcErrorFlag     = NULL;
-
   InitArrays();
 }
 
 //_____________________________________________________________________________
 THcCherenkov::~THcCherenkov() {
   // Destructor
-  delete frAdcPedRaw;
-  frAdcPedRaw = NULL;
-  delete frAdcPulseIntRaw;
-  frAdcPulseIntRaw = NULL;
-  delete frAdcPulseAmpRaw;
-  frAdcPulseAmpRaw = NULL;
-  delete frAdcPulseTimeRaw;
-  frAdcPulseTimeRaw = NULL;
-  delete frAdcPed;
-  frAdcPed = NULL;
-  delete frAdcPulseInt;
-  frAdcPulseInt = NULL;
-  delete frAdcPulseAmp;
-  frAdcPulseAmp = NULL;
-  delete frAdcPulseTime;
-  frAdcPulseTime = NULL;
-  delete fAdcErrorFlag;
-  fAdcErrorFlag = NULL;
-
   DeleteArrays();
 }
 
@@ -285,21 +247,35 @@ Int_t THcCherenkov::DefineVariables(EMode mode) {
     RVarDef vars[] = {
         {"numAdcHits", "Number of ADC Hits Per PMT", "fNumAdcHits"},     // Cherenkov occupancy
         {"totNumAdcHits", "Total Number of ADC Hits", "fTotNumAdcHits"}, // Cherenkov multiplicity
-        {"adcPedRaw", "Raw ADC pedestals", "frAdcPedRaw.THcSignalHit.GetData()"},
-        {"adcPulseIntRaw", "Raw ADC pulse integrals", "frAdcPulseIntRaw.THcSignalHit.GetData()"},
-        {"adcPulseAmpRaw", "Raw ADC pulse amplitudes", "frAdcPulseAmpRaw.THcSignalHit.GetData()"},
-        {"adcPulseTimeRaw", "Raw ADC pulse times", "frAdcPulseTimeRaw.THcSignalHit.GetData()"},
-        {"adcPed", "ADC pedestals", "frAdcPed.THcSignalHit.GetData()"},
-        {"adcPulseInt", "ADC pulse integrals", "frAdcPulseInt.THcSignalHit.GetData()"},
-        {"adcPulseAmp", "ADC pulse amplitudes", "frAdcPulseAmp.THcSignalHit.GetData()"},
-        {"adcPulseTime", "ADC pulse times", "frAdcPulseTime.THcSignalHit.GetData()"},
         {0}};
     DefineVarsFromList(vars, mode);
+
+    VarDef pulsevars[] = {
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "adcPedRaw", "Raw ADC pedestals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "adcPulseIntRaw", "Raw ADC pulse integrals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "adcPulseAmpRaw", "Raw ADC pulse amplitudes"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "adcPulseTimeRaw", "Raw ADC pulse times"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "adcPed", "ADC pedestals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "adcPulseInt", "ADC pulse integrals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "adcPulseAmp", "ADC pulse amplitudes"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "adcPulseTime", "ADC pulse times"),
+      { 0 }
+    };
+    DefineVarsFromList(pulsevars, mode);
+    if (mode == kDefine)
+      THcAdcPulseTable::CheckVariables(pulsevars, GetPrefix());
   } // end debug statement
 
+  VarDef pulsevars[] = {
+    fAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "adcCounter", "ADC counter numbers"),
+    fAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "adcErrorFlag", "Error Flag for When FPGA Fails"),
+    { 0 }
+  };
+  DefineVarsFromList(pulsevars, mode);
+  if (mode == kDefine)
+    THcAdcPulseTable::CheckVariables(pulsevars, GetPrefix());
+
   RVarDef vars[] = {
-      {"adcCounter", "ADC counter numbers", "frAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},
-      {"adcErrorFlag", "Error Flag for When FPGA Fails", "fAdcErrorFlag.THcSignalHit.GetData()"},
       {"numGoodAdcHits", "Number of Good ADC Hits Per PMT",
        "fNumGoodAdcHits"}, // Cherenkov occupancy
       {"totNumGoodAdcHits", "Total Number of Good ADC Hits",
@@ -361,16 +337,7 @@ void THcCherenkov::Clear(Option_t* opt) {
 
   fNpeSum = 0.0;
 
-  frAdcPedRaw->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
-  fAdcErrorFlag->Clear();
+  fAdcPulses.Clear();
 
   for (UInt_t ielem = 0; ielem < fNumAdcHits.size(); ielem++)
     fNumAdcHits.at(ielem) = 0;
@@ -418,7 +385,6 @@ Int_t THcCherenkov::Decode(const THaEvData& evdata) {
   }
 
   Int_t  ihit      = 0;
-  UInt_t nrAdcHits = 0;
   _waveforms.clear();
 
   while (ihit < fNhits) {
@@ -432,30 +398,9 @@ Int_t THcCherenkov::Decode(const THaEvData& evdata) {
 
     for (UInt_t thit = 0; thit < rawAdcHit.GetNPulses(); thit++) {
 
-      ((THcSignalHit*)frAdcPedRaw->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPedRaw());
-      ((THcSignalHit*)frAdcPed->ConstructedAt(nrAdcHits))->Set(npmt, rawAdcHit.GetPed());
-
-      ((THcSignalHit*)frAdcPulseIntRaw->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*)frAdcPulseInt->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*)frAdcPulseAmpRaw->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*)frAdcPulseAmp->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*)frAdcPulseTimeRaw->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*)frAdcPulseTime->ConstructedAt(nrAdcHits))
-          ->Set(npmt, rawAdcHit.GetPulseTime(thit) + fAdcTdcOffset);
-
-      if (rawAdcHit.GetPulseAmpRaw(thit) > 0)
-        ((THcSignalHit*)fAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(npmt, 0);
-      if (rawAdcHit.GetPulseAmpRaw(thit) <= 0)
-        ((THcSignalHit*)fAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(npmt, 1);
+      fAdcPulses.AddPulse(npmt, rawAdcHit, thit, fAdcTdcOffset,
+                          rawAdcHit.GetPulseAmpRaw(thit) <= 0);
 
-      ++nrAdcHits;
       fTotNumAdcHits++;
       fNumAdcHits.at(npmt - 1) = npmt;
     }
@@ -476,12 +421,12 @@ Int_t THcCherenkov::CoarseProcess(TClonesArray&) {
     fAdcGoodElem[ipmt]=-1;
    }
    //
-  for(Int_t ielem = 0; ielem < frAdcPulseInt->GetEntries(); ielem++) {
-    Int_t    npmt         = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseTime    = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
+  for(Int_t ielem = 0; ielem < (Int_t)fAdcPulses.GetSize(); ielem++) {
+    Int_t    npmt         = fAdcPulses.GetPaddle(ielem) - 1;
+    Double_t pulseTime    = fAdcPulses.GetPulseTime(ielem);
+    Double_t pulseAmp     = fAdcPulses.GetPulseAmp(ielem);
    Double_t adctdcdiffTime = StartTime-pulseTime;
-     Bool_t   errorFlag    = ((THcSignalHit*) fAdcErrorFlag->ConstructedAt(ielem))->GetData();
+     Bool_t   errorFlag    = fAdcPulses.GetErrorFlag(ielem);
     Bool_t   pulseTimeCut = adctdcdiffTime > fAdcTimeWindowMin[npmt] && adctdcdiffTime < fAdcTimeWindowMax[npmt];
     if (!errorFlag)
       {
@@ -496,11 +441,11 @@ Int_t THcCherenkov::CoarseProcess(TClonesArray&) {
   for(Int_t npmt = 0; npmt < fNelem; npmt++) {
     Int_t ielem = fAdcGoodElem[npmt];
     if (ielem != -1) {
-    Double_t pulsePed     = ((THcSignalHit*) frAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t pulseInt     = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulseIntRaw  = ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp     = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime    = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
+    Double_t pulsePed     = fAdcPulses.GetPed(ielem);
+    Double_t pulseInt     = fAdcPulses.GetPulseInt(ielem);
+    Double_t pulseIntRaw  = fAdcPulses.GetPulseIntRaw(ielem);
+    Double_t pulseAmp     = fAdcPulses.GetPulseAmp(ielem);
+    Double_t pulseTime    = fAdcPulses.GetPulseTime(ielem);
    Double_t adctdcdiffTime = StartTime-pulseTime;
     // By default, the last hit within the timing cut will be considered "good"
       fGoodAdcPed.at(npmt)         = pulsePed;
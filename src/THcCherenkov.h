@@ -11,6 +11,7 @@
 #include "THaNonTrackingDetector.h"
 #include "THcHitList.h"
 #include "THcCherenkovHit.h"
+#include "THcAdcPulseTable.h"
 
 #include "hcana/Logger.h"
 #include "hcana/HallC_Data.h"
@@ -119,15 +120,7 @@ public:
   Int_t*    fAdcGoodElem;
 
   // 12 Gev FADC variables
-  TClonesArray* frAdcPedRaw;
-  TClonesArray* frAdcPulseIntRaw;
-  TClonesArray* frAdcPulseAmpRaw;
-  TClonesArray* frAdcPulseTimeRaw;
-  TClonesArray* frAdcPed;
-  TClonesArray* frAdcPulseInt;
-  TClonesArray* frAdcPulseAmp;
-  TClonesArray* frAdcPulseTime;
-  TClonesArray* fAdcErrorFlag;
+  THcAdcPulseTable fAdcPulses;  // All FADC pulses of the event
 
   void Setup(const char* name, const char* description);
   virtual void  InitializePedestals( );
@@ -19,6 +19,7 @@ the number of parameters per plane.
 #include "THaDetMap.h"
 #include "THaEvData.h"
 #include "THaTrack.h"
+#include "THcDCFit.h"
 #include "THcDCTrack.h"
 #include "THcDetectorMap.h"
 #include "THcGlobals.h"
@@ -29,6 +30,7 @@ the number of parameters per plane.
 #include "VarDef.h"
 #include "VarType.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -80,6 +82,9 @@ THcDC::THcDC(const char* name, const char* description, THaApparatus* apparatus)
   fFixLR                    = 1;
   fFixPropagationCorrection = 1;
   fProjectToChamber         = 0; // Use 1 for SOS chambers
+  fTrackFitMatrix           = 0;
+  fLinkStubsHash            = 1;
+  fLinkMaxSp                = 1000;
 
   fDCTracks = new TClonesArray("THcDCTrack", 20);
 
@@ -152,6 +157,10 @@ void THcDC::Setup(const char* name, const char* description) {
 
     // Should quit.  Is there an official way to quit?
   }
+  if (fNPlanes > hallc::data::DriftChamber::MaxNPlanes) {
+    _det_logger->warn("Only the first {} of {} planes are written to the {} data branch",
+                      hallc::data::DriftChamber::MaxNPlanes, fNPlanes, GetName());
+  }
   fPlaneNames = new char*[fNPlanes];
   for (Int_t i = 0; i < fNPlanes; i++) {
     fPlaneNames[i] = new char[plane_names[i].length() + 1];
@@ -254,6 +263,8 @@ THaAnalysisObject::EStatus THcDC::Init(const TDatime& date) {
   fResidualsExclPlane = new Double_t[fNPlanes];
   fWire_hit_did       = new Double_t[fNPlanes];
   fWire_hit_should    = new Double_t[fNPlanes];
+  _basic_data._NPlanes =
+      TMath::Min(fNPlanes, static_cast<Int_t>(hallc::data::DriftChamber::MaxNPlanes));
 
   // Replace with what we need for Hall C
   //  const DataDest tmp[NDEST] = {
@@ -383,6 +394,9 @@ Int_t THcDC::ReadDatabase(const TDatime& date) {
                       {"ypt_track_criterion", &fYptTrCriterion, kDouble},
                       {"dc_fix_lr", &fFixLR, kInt},
                       {"dc_fix_propcorr", &fFixPropagationCorrection, kInt},
+                      {"dc_track_fit_matrix", &fTrackFitMatrix, kInt, 0, 1},
+                      {"dc_link_stubs_hash", &fLinkStubsHash, kInt, 0, 1},
+                      {"dc_link_max_sp", &fLinkMaxSp, kInt, 0, 1},
                       {"debuglinkstubs", &fdebuglinkstubs, kInt},
                       {"debugprintrawdc", &fdebugprintrawdc, kInt},
                       {"debugprintdecodeddc", &fdebugprintdecodeddc, kInt},
@@ -391,6 +405,9 @@ Int_t THcDC::ReadDatabase(const TDatime& date) {
                       {"debugtrackprint", &fdebugtrackprint, kInt},
                       {0}};
   fSingleStub      = 0;
+  fTrackFitMatrix  = 0;
+  fLinkStubsHash   = 1;
+  fLinkMaxSp       = 1000;
   for (Int_t ip = 0; ip < fNPlanes; ip++) {
     fReadoutLR[ip] = 0.0;
     fReadoutTB[ip] = 0.0;
@@ -583,6 +600,9 @@ inline void THcDC::ClearEvent() {
   for (UInt_t i = 0; i < fNChambers; i++) {
     fChambers[i]->Clear();
   }
+  // Tracks stay allocated, LinkStubs reuses them
+  fNDCTracks = 0;
+  fDCTracks->Clear();
 
   for (Int_t i = 0; i < fNPlanes; i++) {
     fResiduals[i]          = 1000.0;
@@ -590,6 +610,7 @@ inline void THcDC::ClearEvent() {
     fWire_hit_did[i]       = 1000.0;
     fWire_hit_should[i]    = 1000.0;
   }
+  _basic_data.Clear();
 
   //  fTrackProj->Clear();
 }
@@ -619,6 +640,7 @@ Int_t THcDC::Decode(const THaEvData& evdata) {
     for (Int_t ip = 0; ip < fNPlanes; ip++) {
       nexthit = fPlanes[ip]->ProcessHits(fRawHitList, nexthit);
       fN_True_RawHits += fPlanes[ip]->GetNRawhits();
+      fNHitsHigh = TMath::Max(fNHitsHigh, fPlanes[ip]->GetNRawhits());
     }
 
     // fRawHitList is TClones array of THcRawDCHit objects
@@ -672,6 +694,8 @@ Int_t THcDC::CoarseTrack(TClonesArray& tracks) {
     fChambers[i]->FindSpacePoints();
     fChambers[i]->CorrectHitTimes();
     fChambers[i]->LeftRight();
+    fNSpacePointsHigh =
+        TMath::Max(fNSpacePointsHigh, fChambers[i]->GetSpacePointsP()->GetLast() + 1);
   }
   if (fdebugflagstubs)
     PrintSpacePoints();
@@ -679,6 +703,7 @@ Int_t THcDC::CoarseTrack(TClonesArray& tracks) {
     PrintStubs();
   // Now link the stubs between chambers
   LinkStubs();
+  fNDCTracksHigh = TMath::Max(fNDCTracksHigh, fDCTracks->GetLast() + 1);
   if (fNDCTracks > 0) {
     TrackFit();
     // Copy tracks into podd tracks list
@@ -725,10 +750,12 @@ void THcDC::SetFocalPlaneBestTrack(Int_t golden_track_index) {
   for (UInt_t ihit = 0; ihit < UInt_t(tr1->GetNHits()); ihit++) {
     THcDCHit* hit                          = tr1->GetHit(ihit);
     Int_t     plane                        = hit->GetPlaneNum() - 1;
-    _basic_data._Residuals[plane]          = tr1->GetResidual(plane);
     fResiduals[plane]                      = tr1->GetResidual(plane);
-    _basic_data._ResidualsExclPlane[plane] = tr1->GetResidualExclPlane(plane);
     fResidualsExclPlane[plane]             = tr1->GetResidualExclPlane(plane);
+    if (plane < _basic_data._NPlanes) {
+      _basic_data._Residuals[plane]          = fResiduals[plane];
+      _basic_data._ResidualsExclPlane[plane] = fResidualsExclPlane[plane];
+    }
   }
   EfficiencyPerWire(golden_track_index);
 }
@@ -742,13 +769,18 @@ void THcDC::EfficiencyPerWire(Int_t golden_track_index) {
     track_pos            = tr1->GetCoord(plane);
     Int_t wire_num       = hit->GetWireNum();
     Int_t wire_track_num = round(fPlanes[plane]->CalcWireFromPos(track_pos));
-    if ((wire_num - wire_track_num) == 0)
+    if ((wire_num - wire_track_num) == 0) {
       fWire_hit_did[plane] = wire_num;
+      if (plane < _basic_data._NPlanes)
+        _basic_data._Wire_hit_did[plane] = wire_num;
+    }
   }
   for (Int_t ip = 0; ip < fNPlanes; ip++) {
     track_pos            = tr1->GetCoord(ip);
     Int_t wire_should    = round(fPlanes[ip]->CalcWireFromPos(track_pos));
     fWire_hit_should[ip] = wire_should;
+    if (ip < _basic_data._NPlanes)
+      _basic_data._Wire_hit_should[ip] = wire_should;
   }
 }
 //
@@ -806,12 +838,11 @@ void THcDC::LinkStubs() {
                        stubs.
   */
 
-  std::vector<THcSpacePoint*> fSp;
+  std::vector<THcSpacePoint*>& fSp = fLinkSp;
   fNSp = 0;
   fSp.clear();
-  fSp.reserve(100);
   fNDCTracks = 0; // Number of Focal Plane tracks found
-  fDCTracks->Delete();
+  fDCTracks->Clear();
   // Make a vector of pointers to the SpacePoints
   // if (fChambers[0]->GetNSpacePoints()+fChambers[1]->GetNSpacePoints()>10) return;
 
@@ -822,13 +853,16 @@ void THcDC::LinkStubs() {
       fSp.push_back(static_cast<THcSpacePoint*>(spacepointarray->At(isp)));
       fSp[fNSp]->fNChamber       = nchamber;
       fSp[fNSp]->fNChamber_spnum = isp;
+      fSp[fNSp]->SetNTracks(0);
       fNSp++;
-      if (ich == 0 && fNSp > 50)
+      if (ich == 0 && fNSp > fLinkMaxSp / 2)
         break;
-      if (fNSp > 100)
+      if (fNSp > fLinkMaxSp)
         break;
     }
   }
+  if (fSingleStub == 0 && fLinkStubsHash)
+    BuildLinkCells();
   Double_t stubminx  = 999999;
   Double_t stubminy  = 999999;
   Double_t stubminxp = 999999;
@@ -839,40 +873,26 @@ void THcDC::LinkStubs() {
          isp1++) { // isp1 is index/id in total list of space points
       THcSpacePoint* sp1      = fSp[isp1];
       Int_t          sptracks = 0;
-      // Now make sure this sp is not already used in a sp.
-      // Could this be done by having a sp point to the track it is in?
-      Int_t tryflag = 1;
-      for (UInt_t itrack = 0; itrack < fNDCTracks; itrack++) {
-        THcDCTrack* theDCTrack = static_cast<THcDCTrack*>(fDCTracks->At(itrack));
-        for (Int_t isp = 0; isp < theDCTrack->GetNSpacePoints(); isp++) {
-          // isp is index into list of space points attached to theDCTrack
-          if (theDCTrack->GetSpacePoint(isp) == sp1) {
-            tryflag = 0;
-          }
-        }
-      }
-      if (tryflag) { // SP not already part of a track
+      // Now make sure this sp is not already used in a track.
+      if (sp1->GetNTracks() == 0) { // SP not already part of a track
         Int_t newtrack = 1;
-        for (Int_t isp2 = isp1 + 1; isp2 < fNSp; isp2++) {
-          THcSpacePoint* sp2 = fSp[isp2];
+        // Later space points that may pass the track criteria, in order
+        if (fLinkStubsHash) {
+          FindLinkCandidates(isp1, fLinkCand);
+        } else {
+          fLinkCand.clear();
+          for (Int_t isp2 = isp1 + 1; isp2 < fNSp; isp2++)
+            fLinkCand.push_back(isp2);
+        }
+        for (UInt_t icand = 0; icand < fLinkCand.size(); icand++) {
+          THcSpacePoint* sp2 = fSp[fLinkCand[icand]];
           if (sp1->fNChamber != sp2->fNChamber && sp1->GetSetStubFlag() && sp2->GetSetStubFlag()) {
             Double_t* spstub1 = sp1->GetStubP();
             Double_t* spstub2 = sp2->GetStubP();
             Double_t  dposx   = spstub1[0] - spstub2[0];
-            Double_t  dposy;
-            if (fProjectToChamber) { // From SOS s_link_stubs
-              // Since single chamber resolution is ~50mr, and the maximum y`
-              // angle is about 30mr, use differenece between y AT CHAMBERS, rather
-              // than at focal plane.  (Project back to chamber, to take out y' uncertainty)
-              // (Should this be done for SHMS and HMS too?)
-              Double_t y1 = spstub1[1] + fChambers[sp1->fNChamber]->GetZPos() * spstub1[3];
-              Double_t y2 = spstub2[1] + fChambers[sp2->fNChamber]->GetZPos() * spstub2[3];
-              dposy       = y1 - y2;
-            } else {
-              dposy = spstub1[1] - spstub2[1];
-            }
-            Double_t dposxp = spstub1[2] - spstub2[2];
-            Double_t dposyp = spstub1[3] - spstub2[3];
+            Double_t  dposy   = LinkStubY(sp1) - LinkStubY(sp2);
+            Double_t  dposxp  = spstub1[2] - spstub2[2];
+            Double_t  dposyp  = spstub1[3] - spstub2[3];
 
             // What is the point of saving these stubmin values.  They
             // Don't seem to be used anywhere except that they can be
@@ -899,7 +919,7 @@ void THcDC::LinkStubs() {
                 if (fNDCTracks < fNTracksMaxFP) {
                   sptracks                = 0; // Number of tracks with this seed
                   stub_tracks[sptracks++] = fNDCTracks;
-                  THcDCTrack* theDCTrack  = new ((*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+                  THcDCTrack* theDCTrack  = NewDCTrack();
                   theDCTrack->AddSpacePoint(sp1);
                   theDCTrack->AddSpacePoint(sp2);
                   if (sp1->fNChamber == 1)
@@ -949,8 +969,7 @@ void THcDC::LinkStubs() {
                       // same space points except spoint
                       if (fNDCTracks < MAXTRACKS) {
                         stub_tracks[sptracks++] = fNDCTracks;
-                        THcDCTrack* newDCTrack =
-                            new ((*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+                        THcDCTrack* newDCTrack = NewDCTrack();
                         for (Int_t isp = 0; isp < theDCTrack->GetNSpacePoints(); isp++) {
                           if (isp != spoint) {
                             newDCTrack->AddSpacePoint(theDCTrack->GetSpacePoint(isp));
@@ -985,7 +1004,7 @@ void THcDC::LinkStubs() {
             }         // criterion
           }           // end test on same chamber
         }             // end isp2 loop over new space points
-      }               // end test on tryflag
+      }               // end test on sp already in a track
     }                 // end isp1 outer loop over space points
     //
     //
@@ -994,7 +1013,7 @@ void THcDC::LinkStubs() {
       if (fNDCTracks < MAXTRACKS) {
         // Need some constructed t thingy
         if (fSp[isp]->GetSetStubFlag()) {
-          THcDCTrack* newDCTrack = new ((*fDCTracks)[fNDCTracks++]) THcDCTrack(fNPlanes);
+          THcDCTrack* newDCTrack = NewDCTrack();
           newDCTrack->AddSpacePoint(fSp[isp]);
         }
       } else {
@@ -1022,6 +1041,179 @@ void THcDC::LinkStubs() {
   }
 }
 
+//_____________________________________________________________________________
+THcDCTrack* THcDC::NewDCTrack() {
+  /**
+     Next track of fDCTracks.  Objects left from earlier events are reset
+     and reused, so their hit lists keep their capacity.
+  */
+  THcDCTrack* theDCTrack = static_cast<THcDCTrack*>(fDCTracks->ConstructedAt(fNDCTracks++));
+  theDCTrack->Reset(fNPlanes);
+  return theDCTrack;
+}
+
+//_____________________________________________________________________________
+Double_t THcDC::LinkStubY(THcSpacePoint* sp) {
+  /**
+     The y compared by LinkStubs: at the focal plane, or projected to the
+     chamber if fProjectToChamber is set.
+  */
+  Double_t* stub = sp->GetStubP();
+  if (fProjectToChamber) { // From SOS s_link_stubs
+    // Since single chamber resolution is ~50mr, and the maximum y`
+    // angle is about 30mr, use differenece between y AT CHAMBERS, rather
+    // than at focal plane.  (Project back to chamber, to take out y' uncertainty)
+    // (Should this be done for SHMS and HMS too?)
+    return stub[1] + fChambers[sp->fNChamber]->GetZPos() * stub[3];
+  }
+  return stub[1];
+}
+
+// Cells of LinkStubs are indexed by 16 bits per stub coordinate
+static const Int_t kLinkCellMax = 32767;
+
+static Int_t LinkCellIndex(Double_t v, Double_t criterion) {
+  Double_t c = TMath::Floor(v / criterion);
+  if (!(c > -kLinkCellMax)) // Also catches NaN
+    return -kLinkCellMax;
+  if (c > kLinkCellMax)
+    return kLinkCellMax;
+  return static_cast<Int_t>(c);
+}
+
+static ULong64_t LinkCellKey(const Int_t* idx) {
+  // Four 16 bit fields, each index shifted to 1..65535
+  ULong64_t key = 0;
+  for (Int_t i = 0; i < 4; i++)
+    key = (key << 16) | static_cast<ULong64_t>(idx[i] + kLinkCellMax + 1);
+  return key;
+}
+
+//_____________________________________________________________________________
+void THcDC::BuildLinkCells() {
+  /**
+     Put the space points with a stub in cells a bit wider than the track
+     criteria in x, y, xp and yp.  Two stubs that pass all four criteria
+     are then in the same or in neighbouring cells, also after rounding.
+  */
+  fLinkCells.clear();
+  fLinkCellIdx.assign(4 * fNSp, 0);
+  if (fXtTrCriterion <= 0 || fYtTrCriterion <= 0 || fXptTrCriterion <= 0 ||
+      fYptTrCriterion <= 0)
+    return; // Nothing can pass
+  for (Int_t isp = 0; isp < fNSp; isp++) {
+    THcSpacePoint* sp = fLinkSp[isp];
+    if (!sp->GetSetStubFlag())
+      continue;
+    Int_t* idx = &fLinkCellIdx[4 * isp];
+    idx[0]     = LinkCellIndex(sp->GetStubX(), 1.01 * fXtTrCriterion);
+    idx[1]     = LinkCellIndex(LinkStubY(sp), 1.01 * fYtTrCriterion);
+    idx[2]     = LinkCellIndex(sp->GetStubXP(), 1.01 * fXptTrCriterion);
+    idx[3]     = LinkCellIndex(sp->GetStubYP(), 1.01 * fYptTrCriterion);
+    fLinkCells.push_back(std::make_pair(LinkCellKey(idx), isp));
+  }
+  std::sort(fLinkCells.begin(), fLinkCells.end());
+}
+
+//_____________________________________________________________________________
+void THcDC::FindLinkCandidates(Int_t isp1, std::vector<Int_t>& cand) {
+  /**
+     Space points after isp1 in the 3^4 cells around its cell, in
+     increasing order, so LinkStubs sees them in the same order as when
+     it tries all pairs.
+  */
+  cand.clear();
+  if (fLinkCells.empty() || !fLinkSp[isp1]->GetSetStubFlag())
+    return;
+  const Int_t* idx1 = &fLinkCellIdx[4 * isp1];
+  Int_t        idx[4];
+  for (Int_t ic = 0; ic < 81; ic++) {
+    Int_t code = ic;
+    for (Int_t i = 0; i < 4; i++) {
+      idx[i] = idx1[i] + code % 3 - 1;
+      code /= 3;
+    }
+    if (TMath::Abs(idx[0]) > kLinkCellMax || TMath::Abs(idx[1]) > kLinkCellMax ||
+        TMath::Abs(idx[2]) > kLinkCellMax || TMath::Abs(idx[3]) > kLinkCellMax)
+      continue;
+    ULong64_t key = LinkCellKey(idx);
+    std::vector<std::pair<ULong64_t, Int_t> >::const_iterator it =
+        std::lower_bound(fLinkCells.begin(), fLinkCells.end(), std::make_pair(key, isp1 + 1));
+    for (; it != fLinkCells.end() && it->first == key; ++it)
+      cand.push_back(it->second);
+  }
+  std::sort(cand.begin(), cand.end());
+}
+
+//_____________________________________________________________________________
+Bool_t THcDC::TrackFitCholesky(THcDCTrack* theDCTrack, const Double_t* coords, const Int_t* planes) {
+  /**
+     Fit of one track with THcDCFit, same results as the TMatrixD fit in
+     TrackFit.  The residuals without a plane come from the full fit
+     through the leverage of the hit instead of one refit per hit.
+     Returns false, with the track untouched, if the normal equations
+     can not be solved so the caller can use the matrix fit.
+  */
+  const Int_t raycoeffmap[] = {4, 5, 2, 3};
+  const Int_t nhits         = theDCTrack->GetNHits();
+
+  if (theDCTrack->GetNFree() <= 0) {
+    theDCTrack->SetChisq(1.0E4);
+    return kTRUE;
+  }
+
+  Double_t a[nhits][NUM_FPRAY];
+  Double_t w[nhits];
+  THcDCFit fit;
+  for (Int_t ihit = 0; ihit < nhits; ihit++) {
+    // Sigma is per wire, so the weight can not be cached per plane
+    Double_t sigma = theDCTrack->GetHit(ihit)->GetWireSigma();
+    w[ihit]        = 1.0 / (sigma * sigma);
+    for (Int_t ir = 0; ir < NUM_FPRAY; ir++) {
+      a[ihit][ir] = fPlaneCoeffs[planes[ihit]][raycoeffmap[ir]];
+    }
+    fit.AddMeasurement(a[ihit], w[ihit], coords[ihit]);
+  }
+
+  Double_t dray[NUM_FPRAY];
+  if (!fit.Solve(dray))
+    return kFALSE;
+
+  for (Int_t iplane = 0; iplane < fNPlanes; iplane++) {
+    Double_t coord = 0.0;
+    for (Int_t ir = 0; ir < NUM_FPRAY; ir++) {
+      coord += fPlaneCoeffs[iplane][raycoeffmap[ir]] * dray[ir];
+    }
+    theDCTrack->SetCoord(iplane, coord);
+  }
+
+  Double_t chi2 = 0.0;
+  for (Int_t ihit = 0; ihit < nhits; ihit++) {
+    Double_t residual = coords[ihit] - theDCTrack->GetCoord(planes[ihit]);
+    theDCTrack->SetResidual(planes[ihit], residual);
+    chi2 += residual * residual * w[ihit];
+
+    // Residual to the fit without this hit
+    Double_t denom = 1.0 - w[ihit] * fit.Leverage(a[ihit]);
+    if (denom > 1e-9) {
+      theDCTrack->SetResidualExclPlane(planes[ihit], residual / denom);
+    } else {
+      Double_t dray1[NUM_FPRAY];
+      if (fit.SolveWithout(a[ihit], w[ihit], coords[ihit], dray1)) {
+        Double_t coord = 0.0;
+        for (Int_t ir = 0; ir < NUM_FPRAY; ir++) {
+          coord += a[ihit][ir] * dray1[ir];
+        }
+        theDCTrack->SetResidualExclPlane(planes[ihit], coords[ihit] - coord);
+      }
+    }
+  }
+  theDCTrack->SetVector(dray[0], dray[1], 0.0, dray[2], dray[3]);
+  theDCTrack->SetChisq(chi2);
+
+  return kTRUE;
+}
+
 //_____________________________________________________________________________
 void THcDC::TrackFit() {
   /**
@@ -1060,6 +1252,8 @@ void THcDC::TrackFit() {
     } // end loop over hits
 
     theDCTrack->SetNFree(theDCTrack->GetNHits() - NUM_FPRAY);
+    if (!fTrackFitMatrix && TrackFitCholesky(theDCTrack, coords, planes))
+      continue;
     Double_t chi2 = dummychi2;
     if (theDCTrack->GetNFree() > 0) {
       TVectorD TT(NUM_FPRAY);
@@ -1352,6 +1546,16 @@ Double_t THcDC::DpsiFun(Double_t ray[4], Int_t plane) {
 Int_t THcDC::End(THaRunBase* run) {
   //  EffCalc();
   MissReport(Form("%s.%s", GetApparatus()->GetName(), GetName()));
+  _det_logger->info("{}.{}: most hits in a plane {}, space points in a chamber {}, tracks {}",
+                    GetApparatus()->GetName(), GetName(), fNHitsHigh, fNSpacePointsHigh,
+                    fNDCTracksHigh);
+  for (UInt_t i = 0; i < fNChambers; i++) {
+    if (fChambers[i]->GetSpacePointGridCheck()) {
+      _det_logger->info("{}.{}: chamber {}, space point grid and scan disagreed in {} events",
+                        GetApparatus()->GetName(), GetName(), fChambers[i]->GetChamberNum(),
+                        fChambers[i]->GetNGridMismatch());
+    }
+  }
   return 0;
 }
 
@@ -1376,6 +1580,14 @@ void THcDC::EffInit() {
     fPlaneEvents[i] = 0;
   }
   gHcParms->Define(Form("%sdc_tot_events", fPrefix), "Total DC Events", fTotEvents);
+  fNHitsHigh        = 0;
+  fNSpacePointsHigh = 0;
+  fNDCTracksHigh    = 0;
+  gHcParms->Define(Form("%sdc_hits_high", fPrefix), "Most DC hits in a plane", fNHitsHigh);
+  gHcParms->Define(Form("%sdc_sp_high", fPrefix), "Most space points in a chamber",
+                   fNSpacePointsHigh);
+  gHcParms->Define(Form("%sdc_tracks_high", fPrefix), "Most focal plane tracks",
+                   fNDCTracksHigh);
   gHcParms->Define(Form("%sdc_cham_hits[%d]", fPrefix, fNChambers),
                    "N events with hits per chamber", *fNChamHits);
   gHcParms->Define(Form("%sdc_events[%d]", fPrefix, fNPlanes), "N events with hits per plane",
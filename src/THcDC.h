@@ -16,6 +16,7 @@
 #include "TMath.h"
 
 #include <map>
+#include <algorithm>
 #include "hcana/Logger.h"
 
 #define NUM_FPRAY 4
@@ -23,18 +24,49 @@
 namespace hallc {
   namespace data {
 
-    /** Drift chamber data.
-     *  Currently just for testing
+    /** Drift chamber data, indexed by plane number - 1.
+     *
+     *  Version 1 kept std::map<int,double> per quantity.  Version 2 uses
+     *  fixed width arrays, so nothing is allocated per event and the
+     *  branch splits into plain leaves.  Planes without a value hold
+     *  kNoValue.  Version 1 branches are converted when they are read by
+     *  the I/O rule in HallC_LinkDef.h, which uses FromMap.
      */
     struct DriftChamber {
-
-      // Plane number  
-      std::map<int,double> _Residuals;
-      std::map<int,double> _ResidualsExclPlane;
-      std::map<int,double> _Wire_hit_did;      
-      std::map<int,double> _Wire_hit_should;   
-
-      ClassDef(DriftChamber,1)
+      static constexpr int MaxNPlanes = 12;
+      static constexpr double kNoValue = 1000.0;
+
+      int    _NPlanes = 0;                      // Planes in use
+      double _Residuals[MaxNPlanes];
+      double _ResidualsExclPlane[MaxNPlanes];
+      double _Wire_hit_did[MaxNPlanes];
+      double _Wire_hit_should[MaxNPlanes];
+
+      DriftChamber() { Clear(); }
+      virtual ~DriftChamber() {}
+
+      void Clear() {
+        std::fill_n(_Residuals, MaxNPlanes, kNoValue);
+        std::fill_n(_ResidualsExclPlane, MaxNPlanes, kNoValue);
+        std::fill_n(_Wire_hit_did, MaxNPlanes, kNoValue);
+        std::fill_n(_Wire_hit_should, MaxNPlanes, kNoValue);
+      }
+
+      // Copy a version 1 plane map into a plane array.  Returns the
+      // number of planes covered by the map.
+      static int FromMap(const std::map<int,double>& m, double* a) {
+        int nplanes = 0;
+        std::fill_n(a, MaxNPlanes, kNoValue);
+        for (const auto& p : m) {
+          if (p.first < 0 || p.first >= MaxNPlanes)
+            continue;
+          a[p.first] = p.second;
+          nplanes    = std::max(nplanes, p.first + 1);
+        }
+        return nplanes;
+      }
+
+      ClassDef(DriftChamber,2)
     };
 
   } // namespace data
@@ -42,6 +74,7 @@ namespace hallc {
 
 //class THaScCalib;
 class TClonesArray;
+class THcDCTrack;
 
 class THcDC : public THaTrackingDetector, public THcHitList {
 
@@ -145,6 +178,11 @@ protected:
   Int_t fProjectToChamber;	// If 1, project y position each stub back to it's own
                                 // chamber before comparing y positions in LinkStubs
                                 // Was used for SOS in ENGINE.
+  Int_t fTrackFitMatrix;	// If 1, fit tracks with the TMatrixD inversion
+                                // instead of THcDCFit (for validation)
+  Int_t fLinkStubsHash;		// If 1, LinkStubs looks up stub pairs in cells of
+                                // the track criteria instead of trying all pairs
+  Int_t fLinkMaxSp;		// Maximum number of space points given to LinkStubs
 
   // Per-event data
   Int_t fStubTest;
@@ -214,6 +252,10 @@ protected:
   Int_t fTotEvents;
   Int_t* fNChamHits;
   Int_t* fPlaneEvents;
+  // High-water marks of the per-event object pools
+  Int_t fNHitsHigh;		// Raw hits in one plane
+  Int_t fNSpacePointsHigh;	// Space points in one chamber
+  Int_t fNDCTracksHigh;		// Focal plane tracks
 
   // Pointer to global var indicating whether this spectrometer is triggered
   // for this event.
@@ -225,6 +267,12 @@ protected:
   // Intermediate structure for building
   static const UInt_t MAXTRACKS = 50;
 
+  // Scratch space of LinkStubs, kept between events
+  std::vector<THcSpacePoint*> fLinkSp;		// Space points of all chambers
+  std::vector<Int_t> fLinkCellIdx;		// Cell indices (x,y,xp,yp) of each
+  std::vector<std::pair<ULong64_t,Int_t> > fLinkCells; // (cell, space point), sorted
+  std::vector<Int_t> fLinkCand;
+
 public:
   THcDriftChamberPlane* GetPlane(unsigned int i_plane) {
     if(i_plane < fNPlanes) {
@@ -244,7 +292,13 @@ protected:
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
   void           LinkStubs();
+  THcDCTrack*    NewDCTrack();
+  Double_t       LinkStubY(THcSpacePoint* sp);
+  void           BuildLinkCells();
+  void           FindLinkCandidates(Int_t isp1, std::vector<Int_t>& cand);
   void           TrackFit();
+  Bool_t         TrackFitCholesky(THcDCTrack* theDCTrack, const Double_t* coords,
+                                  const Int_t* planes);
   Double_t       DpsiFun(Double_t ray[4], Int_t plane);
   void           EffInit();
   void           Eff();
@@ -0,0 +1,121 @@
+/** \class THcDCFit
+    \ingroup DetSupport
+
+\brief Fixed size least squares fit used by THcDC::TrackFit
+
+Replaces the TMatrixD inversion of the 4x4 normal equations of each track.
+For the residuals with one plane left out, the leave-one-out fit differs
+from the full fit by a rank-1 term, so with the leverage
+h = a^T A^-1 a of the left out measurement,
+
+    residual without = residual / (1 - w h)
+
+which only needs one forward substitution with the Cholesky factor.  When
+1 - w h is too small for that to be accurate, SolveWithout does the fit
+again from the downdated normal equations.
+
+*/
+#include "THcDCFit.h"
+#include <cmath>
+
+//_____________________________________________________________________________
+void THcDCFit::Clear()
+{
+  for(Int_t i=0;i<kNPar;i++) {
+    fB[i] = 0.0;
+    for(Int_t j=0;j<kNPar;j++) {
+      fA[i][j] = 0.0;
+      fL[i][j] = 0.0;
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THcDCFit::AddMeasurement(const Double_t* a, Double_t w, Double_t y)
+{
+  for(Int_t i=0;i<kNPar;i++) {
+    Double_t wa = w*a[i];
+    fB[i] += wa*y;
+    for(Int_t j=0;j<=i;j++) {
+      fA[i][j] += wa*a[j];
+    }
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t THcDCFit::Decompose(const Double_t A[kNPar][kNPar], Double_t L[kNPar][kNPar])
+{
+  // Cholesky decomposition A = L L^T, using the lower triangle of A.
+  // Returns false if A is not positive definite.
+  for(Int_t j=0;j<kNPar;j++) {
+    Double_t d = A[j][j];
+    for(Int_t k=0;k<j;k++) d -= L[j][k]*L[j][k];
+    if(!(d > 1e-12*std::fabs(A[j][j]))) return kFALSE;
+    L[j][j] = std::sqrt(d);
+    for(Int_t i=j+1;i<kNPar;i++) {
+      Double_t s = A[i][j];
+      for(Int_t k=0;k<j;k++) s -= L[i][k]*L[j][k];
+      L[i][j] = s/L[j][j];
+    }
+    for(Int_t i=0;i<j;i++) L[i][j] = 0.0;
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void THcDCFit::Substitute(const Double_t L[kNPar][kNPar], const Double_t* b, Double_t* x)
+{
+  // Solve L L^T x = b
+  Double_t z[kNPar];
+  for(Int_t i=0;i<kNPar;i++) {
+    Double_t s = b[i];
+    for(Int_t k=0;k<i;k++) s -= L[i][k]*z[k];
+    z[i] = s/L[i][i];
+  }
+  for(Int_t i=kNPar-1;i>=0;i--) {
+    Double_t s = z[i];
+    for(Int_t k=i+1;k<kNPar;k++) s -= L[k][i]*x[k];
+    x[i] = s/L[i][i];
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t THcDCFit::Solve(Double_t* x)
+{
+  if(!Decompose(fA, fL)) return kFALSE;
+  Substitute(fL, fB, x);
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Double_t THcDCFit::Leverage(const Double_t* a) const
+{
+  // a^T A^-1 a = |L^-1 a|^2, needs Solve first
+  Double_t h = 0.0;
+  Double_t z[kNPar];
+  for(Int_t i=0;i<kNPar;i++) {
+    Double_t s = a[i];
+    for(Int_t k=0;k<i;k++) s -= fL[i][k]*z[k];
+    z[i] = s/fL[i][i];
+    h += z[i]*z[i];
+  }
+  return h;
+}
+
+//_____________________________________________________________________________
+Bool_t THcDCFit::SolveWithout(const Double_t* a, Double_t w, Double_t y, Double_t* x) const
+{
+  // Fit with one measurement taken out of the normal equations
+  Double_t A[kNPar][kNPar];
+  Double_t b[kNPar];
+  Double_t L[kNPar][kNPar];
+  for(Int_t i=0;i<kNPar;i++) {
+    b[i] = fB[i] - w*a[i]*y;
+    for(Int_t j=0;j<=i;j++) {
+      A[i][j] = fA[i][j] - w*a[i]*a[j];
+    }
+  }
+  if(!Decompose(A, L)) return kFALSE;
+  Substitute(L, b, x);
+  return kTRUE;
+}
@@ -0,0 +1,42 @@
+#ifndef ROOT_THcDCFit
+#define ROOT_THcDCFit
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THcDCFit                                                                  //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+/** \brief Weighted linear least squares fit of the 4 focal plane ray
+ * parameters, on the stack.
+ *
+ * Measurements y = a.x with weight w are added to the normal equations
+ * A x = b, which are solved with a Cholesky decomposition of A.  The
+ * decomposition is kept, so the fit without one measurement can be had
+ * from a rank-1 downdate instead of a new fit.
+ */
+class THcDCFit {
+
+public:
+  enum { kNPar = 4 };
+
+  THcDCFit() { Clear(); }
+
+  void     Clear();
+  void     AddMeasurement(const Double_t* a, Double_t w, Double_t y);
+  Bool_t   Solve(Double_t* x);
+  Double_t Leverage(const Double_t* a) const;
+  Bool_t   SolveWithout(const Double_t* a, Double_t w, Double_t y, Double_t* x) const;
+
+protected:
+  static Bool_t Decompose(const Double_t A[kNPar][kNPar], Double_t L[kNPar][kNPar]);
+  static void   Substitute(const Double_t L[kNPar][kNPar], const Double_t* b, Double_t* x);
+
+  Double_t fA[kNPar][kNPar];	// Normal matrix, sum of w a a^T
+  Double_t fB[kNPar];		// Sum of w y a
+  Double_t fL[kNPar][kNPar];	// Cholesky factor of fA, lower
+};
+
+#endif
@@ -20,6 +20,7 @@ fT0(T0), fMaxDriftDistance(MaxDriftDistance), fBinSize(BinSize),
   //Normal constructor
 
   assert( fNumBins > 0 );
+  fInvBinSize = 1.0/fBinSize;
   fTable = new Double_t[fNumBins];
   memcpy( fTable, Table, fNumBins*sizeof(Double_t) );
 }
@@ -38,10 +39,10 @@ Double_t THcDCLookupTTDConv::ConvertTimeToDist(Double_t time)
   /**
      Convert drift time to a distance from the wire by looking up in a table.
   */
-  Int_t ib = (time-fT0)/fBinSize;
+  Int_t ib = (time-fT0)*fInvBinSize;
   Double_t frac = 0;
   if(ib >= 0 && ib+1 < fNumBins) {
-    Double_t tfrac = (time - (ib*fBinSize + fT0)) / fBinSize;
+    Double_t tfrac = (time - (ib*fBinSize + fT0)) * fInvBinSize;
     frac = fTable[ib]*(1-tfrac) + fTable[ib+1]*tfrac;
   } else if (ib+1 >= fNumBins) {
     frac = 1.0;
@@ -53,4 +54,27 @@ Double_t THcDCLookupTTDConv::ConvertTimeToDist(Double_t time)
   return(drift_distance);
 }
 
+//______________________________________________________________________________
+void THcDCLookupTTDConv::ConvertTimeToDist(Int_t n, const Double_t* time, Double_t* dist)
+{
+  /**
+     Same conversion as for a single time, written without branches so
+     that the loop over the times vectorizes.  Times outside the table
+     read a valid bin and the result is replaced.
+  */
+  if(fNumBins < 2) {		// Nothing to interpolate
+    THcDCTimeToDistConv::ConvertTimeToDist(n, time, dist);
+    return;
+  }
+  const Int_t lastbin = fNumBins-2;
+  for(Int_t i=0;i<n;i++) {
+    Int_t ib = (time[i]-fT0)*fInvBinSize;
+    Int_t ibc = ib < 0 ? 0 : (ib > lastbin ? lastbin : ib);
+    Double_t tfrac = (time[i] - (ib*fBinSize + fT0)) * fInvBinSize;
+    Double_t frac = fTable[ibc]*(1-tfrac) + fTable[ibc+1]*tfrac;
+    frac = (ib+1 >= fNumBins) ? 1.0 : (ib < 0 ? 0.0 : frac);
+    dist[i] = fMaxDriftDistance * frac;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,7 @@ public:
   virtual ~THcDCLookupTTDConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time);
+  virtual void     ConvertTimeToDist(Int_t n, const Double_t* time, Double_t* dist);
 
 
 protected:
@@ -26,6 +27,7 @@ protected:
   Double_t fT0;
   Double_t fMaxDriftDistance;
   Double_t fBinSize;
+  Double_t fInvBinSize;
   Int_t fNumBins;
   Double_t* fTable;
 
@@ -17,5 +17,16 @@ THcDCTimeToDistConv::~THcDCTimeToDistConv()
 
 }
 
+//______________________________________________________________________________
+void THcDCTimeToDistConv::ConvertTimeToDist(Int_t n, const Double_t* time, Double_t* dist)
+{
+  /**
+     Convert n drift times at once.  Converters that can do better than
+     one call per time override this.
+  */
+  for(Int_t i=0;i<n;i++) {
+    dist[i] = ConvertTimeToDist(time[i]);
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
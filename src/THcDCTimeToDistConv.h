@@ -18,6 +18,7 @@ public:
   virtual ~THcDCTimeToDistConv();
 
   virtual Double_t ConvertTimeToDist(Double_t time) = 0;
+  virtual void     ConvertTimeToDist(Int_t n, const Double_t* time, Double_t* dist);
 
 private:
 
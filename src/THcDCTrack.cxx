@@ -33,11 +33,13 @@ void THcDCTrack::AddSpacePoint( THcSpacePoint* sp )
 {
   /**
      Add a space point to the list of space points associated with the track.
-     All hits in the SP are added to the tracks hit list.
+     All hits in the SP are added to the tracks hit list, and the SP
+     counts the track in its number of tracks.
   */
 
   if (fnSP <10) {
     fSp[fnSP++] = sp;
+    sp->IncNTracks();
     // Copy all the hits from the space point into the track
     // Will need to also copy the corrected distance and lr information
     for(Int_t ihit=0;ihit<sp->GetNHits();ihit++) {
@@ -60,6 +62,18 @@ void THcDCTrack::Clear( const Option_t* )
   //fResiduals.clear();
   //fDoubleResiduals.clear();
 }
+void THcDCTrack::Reset(Int_t nplanes)
+{
+  /**
+     Return a track reused from an earlier event to the state of a new
+     one.  The vectors keep their capacity.
+  */
+  Clear();
+  fCoords.assign(nplanes, 0.0);
+  fResiduals.assign(nplanes, 0.0);
+  fResidualsExclPlane.assign(nplanes, 0.0);
+  fDoubleResiduals.assign(nplanes, 0.0);
+}
 void THcDCTrack::ClearHits( )
 {
   fNHits = 0;
@@ -19,7 +19,7 @@ class THcDCHit;
 class THcDCTrack : public TObject {
 
 public:
-  THcDCTrack(Int_t nplanes);
+  THcDCTrack(Int_t nplanes=0);
   virtual ~THcDCTrack() {};
 
   virtual void AddSpacePoint(THcSpacePoint* sp);
@@ -61,6 +61,7 @@ public:
 
   // TObject functions redefined
   virtual void Clear( Option_t* opt="" );
+  void Reset(Int_t nplanes);
 
 protected:
   Int_t fnSP; /* Number of space points in this track */
@@ -26,6 +26,7 @@
 
 #include "THaTrackProj.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -51,6 +52,9 @@ THcDriftChamber::THcDriftChamber(
   fSpacePoints = new TClonesArray("THcSpacePoint",10);
 
   fHMSStyleChambers = 0;	// Default
+  fSpacePointGrid = 1;
+  fSpacePointGridCheck = 0;
+  fNGridMismatch = 0;
 }
 
 //_____________________________________________________________________________
@@ -61,6 +65,9 @@ THcDriftChamber::THcDriftChamber() :
   fTrackProj = NULL;
   fSpacePoints = NULL;
   fIsInit = 0;
+  fSpacePointGrid = 1;
+  fSpacePointGridCheck = 0;
+  fNGridMismatch = 0;
 
 }
 //_____________________________________________________________________________
@@ -143,6 +150,8 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
     {"debugflagpr", &fhdebugflagpr, kInt},
     {"debugstubchisq", &fdebugstubchisq, kInt},
     {Form("dc_%d_zpos",fChamberNum), &fZPos, kDouble},
+    {"dc_sppt_grid", &fSpacePointGrid, kInt,0,1},
+    {"dc_sppt_grid_check", &fSpacePointGridCheck, kInt,0,1},
     {0}
   };
   fSmallAngleApprox=0;
@@ -154,6 +163,9 @@ Int_t THcDriftChamber::ReadDatabase( const TDatime& date )
   if (test == HMS ) fRatio_xpfp_to_xfp=0.0011; // HMS 
   fRemove_Sppt_If_One_YPlane = 0; // Default
   fStubMaxXPDiff = 999.;	  // 
+  fSpacePointGrid = 1;		  // Grid search for hard space points
+  fSpacePointGridCheck = 0;	  // Compare grid search with full scan
+  fNGridMismatch = 0;
   gHcParms->LoadParmValues((DBRequest*)&list,prefix);
   // Get parameters parent knows about
   fParent = GetParent();
@@ -240,6 +252,7 @@ Int_t THcDriftChamber::DefineVariables( EMode mode )
     { "stub_y", "", "fSpacePoints.THcSpacePoint.GetStubY()" },
     { "stub_yp", "", "fSpacePoints.THcSpacePoint.GetStubYP()" },
     { "ncombos", "", "fSpacePoints.THcSpacePoint.GetCombos()" },
+    { "grid_mismatch", "Events where space point grid and scan disagreed", "fNGridMismatch" },
     { 0 }
   };
   return DefineVarsFromList( vars, mode );
@@ -316,8 +329,8 @@ Int_t THcDriftChamber::FindSpacePoints( void )
           that do not have nhits >  min_hits and ncombos> min_combos 
           ( exception for easyspacepoint)
   */
-  // fSpacePoints->Clear();
-  fSpacePoints->Delete();
+  // Space points stay allocated, they are cleared when reused
+  fSpacePoints->Clear();
 
   Int_t plane_hitind=0;
   Int_t planep_hitind=0;
@@ -480,70 +493,75 @@ Int_t THcDriftChamber::FindEasySpacePoint_SOS(Int_t xplane_hitind,Int_t xplanep_
 
 //_____________________________________________________________________________
 // Generic
+// Limits on the pairs and combos of FindHardSpacePoints
+static const Int_t kMaxSpacePointPairs = 1000; // Where does this get set?
+static const Int_t kMaxSpacePointCombos = 10*kMaxSpacePointPairs;
+
 Int_t THcDriftChamber::FindHardSpacePoints()
 {
-  Int_t MAX_NUMBER_PAIRS=1000; // Where does this get set?
-  struct Pair {
-    THcDCHit* hit1;
-    THcDCHit* hit2;
-    Double_t x, y;
-  };
-  Pair pairs[MAX_NUMBER_PAIRS];
-  //
-  Int_t ntest_points=0;
+  // Intersections of all pairs of hits in planes at enough of an angle
+  fSPPairs.clear();
   for(Int_t ihit1=0;ihit1<fNhits-1;ihit1++) {
     THcDCHit* hit1=fHits[ihit1];
     THcDriftChamberPlane* plane1 = hit1->GetWirePlane();
     for(Int_t ihit2=ihit1+1;ihit2<fNhits;ihit2++) {
-      if(ntest_points < MAX_NUMBER_PAIRS) {
+      if((Int_t)fSPPairs.size() < kMaxSpacePointPairs) {
 	THcDCHit* hit2=fHits[ihit2];
 	THcDriftChamberPlane* plane2 = hit2->GetWirePlane();
 	Double_t determinate = plane1->GetXsp()*plane2->GetYsp()
 	  -plane1->GetYsp()*plane2->GetXsp();
 	if(TMath::Abs(determinate) > 0.3) { // 0.3 is sin(alpha1-alpha2)=sin(17.5)
-	  pairs[ntest_points].hit1 = hit1;
-	  pairs[ntest_points].hit2 = hit2;
-	  pairs[ntest_points].x = (hit1->GetPos()*plane2->GetYsp()
-				   - hit2->GetPos()*plane1->GetYsp())
+	  SpacePointPair pair;
+	  pair.hit1 = hit1;
+	  pair.hit2 = hit2;
+	  pair.x = (hit1->GetPos()*plane2->GetYsp()
+		    - hit2->GetPos()*plane1->GetYsp())
 	    /determinate;
-	  pairs[ntest_points].y = (hit2->GetPos()*plane1->GetXsp()
-				   - hit1->GetPos()*plane2->GetXsp())
+	  pair.y = (hit2->GetPos()*plane1->GetXsp()
+		    - hit1->GetPos()*plane2->GetXsp())
 	    /determinate;
-	  ntest_points++;
+	  fSPPairs.push_back(pair);
 	}
       }
     }
   }
-  Int_t ncombos=0;
-  struct Combo {
-    Pair* pair1;
-    Pair* pair2;
-  };
-  Combo combos[10*MAX_NUMBER_PAIRS];
-  for(Int_t ipair1=0;ipair1<ntest_points-1;ipair1++) {
-    for(Int_t ipair2=ipair1+1;ipair2<ntest_points;ipair2++) {
-      if(ncombos < 10*MAX_NUMBER_PAIRS) {
-	Double_t dist2 = pow(pairs[ipair1].x - pairs[ipair2].x,2)
-	  + pow(pairs[ipair1].y - pairs[ipair2].y,2);
-	if(dist2 <= fSpacePointCriterion) {
-	  combos[ncombos].pair1 = &pairs[ipair1];
-	  combos[ncombos].pair2 = &pairs[ipair2];
-	  ncombos++;
+  // Pairs of pairs that are close together
+  if(fSpacePointGrid) {
+    FindSpacePointCombosGrid(fSPCombos);
+    if(fSpacePointGridCheck) {	// Regression against the full scan
+      FindSpacePointCombos(fSPCombosCheck);
+      Bool_t same = (fSPCombos.size() == fSPCombosCheck.size());
+      for(UInt_t i=0; same && i<fSPCombos.size(); i++) {
+	same = (fSPCombos[i].pair1 == fSPCombosCheck[i].pair1 &&
+		fSPCombos[i].pair2 == fSPCombosCheck[i].pair2);
+      }
+      if(!same) {
+	if(fNGridMismatch < 10) {
+	  cout << "THcDriftChamber::FindHardSpacePoints: chamber " << fChamberNum
+	       << " grid gives " << fSPCombos.size() << " combos, scan gives "
+	       << fSPCombosCheck.size() << ". Using scan." << endl;
 	}
+	fNGridMismatch++;
+	fSPCombos.swap(fSPCombosCheck);
       }
     }
+  } else {
+    FindSpacePointCombos(fSPCombos);
   }
+  Int_t ncombos=fSPCombos.size();
   // Loop over all valid combinations and build space points
   //if (fhdebugflagpr) cout << "looking for hard Space Point combos = " << ncombos << endl;
   for(Int_t icombo=0;icombo<ncombos;icombo++) {
+    const SpacePointPair& pair1 = fSPPairs[fSPCombos[icombo].pair1];
+    const SpacePointPair& pair2 = fSPPairs[fSPCombos[icombo].pair2];
     THcDCHit* hits[4];
-    hits[0]=combos[icombo].pair1->hit1;
-    hits[1]=combos[icombo].pair1->hit2;
-    hits[2]=combos[icombo].pair2->hit1;
-    hits[3]=combos[icombo].pair2->hit2;
+    hits[0]=pair1.hit1;
+    hits[1]=pair1.hit2;
+    hits[2]=pair2.hit1;
+    hits[3]=pair2.hit2;
     // Get Average Space point xt, yt
-    Double_t xt = (combos[icombo].pair1->x + combos[icombo].pair2->x)/2.0;
-    Double_t yt = (combos[icombo].pair1->y + combos[icombo].pair2->y)/2.0;
+    Double_t xt = (pair1.x + pair2.x)/2.0;
+    Double_t yt = (pair1.y + pair2.y)/2.0;
     // Loop over space points
     
     if(fNSpacePoints > 0) {
@@ -634,6 +652,99 @@ Int_t THcDriftChamber::FindHardSpacePoints()
   return(fNSpacePoints);
 }
 
+//_____________________________________________________________________________
+void THcDriftChamber::FindSpacePointCombos(std::vector<SpacePointCombo>& combos)
+{
+  // All pairs of pairs closer than the space point criterion, by
+  // comparing every pair with every later one
+  combos.clear();
+  Int_t npairs = fSPPairs.size();
+  for(Int_t ipair1=0;ipair1<npairs-1;ipair1++) {
+    for(Int_t ipair2=ipair1+1;ipair2<npairs;ipair2++) {
+      if((Int_t)combos.size() < kMaxSpacePointCombos) {
+	Double_t dist2 = pow(fSPPairs[ipair1].x - fSPPairs[ipair2].x,2)
+	  + pow(fSPPairs[ipair1].y - fSPPairs[ipair2].y,2);
+	if(dist2 <= fSpacePointCriterion) {
+	  SpacePointCombo combo = {ipair1, ipair2};
+	  combos.push_back(combo);
+	}
+      }
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THcDriftChamber::FindSpacePointCombosGrid(std::vector<SpacePointCombo>& combos)
+{
+  // Same combos, in the same order, as FindSpacePointCombos, but only
+  // comparing pairs in neighbouring cells of a grid of the pair
+  // intersections.  Cells are at least the criterion distance wide, so
+  // close pairs are never more than one cell apart.
+  combos.clear();
+  Int_t npairs = fSPPairs.size();
+  if(npairs < 2) return;
+  Double_t cell = 1.01*TMath::Sqrt(fSpacePointCriterion);
+  if(!(cell > 0.0)) {
+    FindSpacePointCombos(combos);
+    return;
+  }
+  Double_t xmin = fSPPairs[0].x, xmax = xmin;
+  Double_t ymin = fSPPairs[0].y, ymax = ymin;
+  for(Int_t i=1;i<npairs;i++) {
+    xmin = TMath::Min(xmin, fSPPairs[i].x); xmax = TMath::Max(xmax, fSPPairs[i].x);
+    ymin = TMath::Min(ymin, fSPPairs[i].y); ymax = TMath::Max(ymax, fSPPairs[i].y);
+  }
+  // Keep the grid about as big as the number of pairs.  Bigger cells
+  // only mean more comparisons.
+  Int_t nx, ny;
+  for(;;) {
+    nx = (Int_t)((xmax-xmin)/cell) + 1;
+    ny = (Int_t)((ymax-ymin)/cell) + 1;
+    if((Double_t)nx*ny <= 4.0*npairs+16) break;
+    cell *= 2.0;
+  }
+
+  // Chain the pairs of each cell, lowest index first
+  fGridHead.assign(nx*ny, -1);
+  fGridNext.resize(npairs);
+  fGridCellX.resize(npairs);
+  fGridCellY.resize(npairs);
+  for(Int_t i=npairs-1;i>=0;i--) {
+    Int_t cx = (Int_t)((fSPPairs[i].x-xmin)/cell);
+    Int_t cy = (Int_t)((fSPPairs[i].y-ymin)/cell);
+    fGridCellX[i] = cx;
+    fGridCellY[i] = cy;
+    fGridNext[i] = fGridHead[cy*nx+cx];
+    fGridHead[cy*nx+cx] = i;
+  }
+
+  for(Int_t ipair1=0;ipair1<npairs-1;ipair1++) {
+    if((Int_t)combos.size() >= kMaxSpacePointCombos) break;
+    fGridCand.clear();
+    for(Int_t cy=fGridCellY[ipair1]-1;cy<=fGridCellY[ipair1]+1;cy++) {
+      if(cy < 0 || cy >= ny) continue;
+      for(Int_t cx=fGridCellX[ipair1]-1;cx<=fGridCellX[ipair1]+1;cx++) {
+	if(cx < 0 || cx >= nx) continue;
+	for(Int_t j=fGridHead[cy*nx+cx];j>=0;j=fGridNext[j]) {
+	  if(j > ipair1) fGridCand.push_back(j);
+	}
+      }
+    }
+    std::sort(fGridCand.begin(), fGridCand.end());
+    for(UInt_t ic=0;ic<fGridCand.size();ic++) {
+      Int_t ipair2 = fGridCand[ic];
+      if((Int_t)combos.size() < kMaxSpacePointCombos) {
+	Double_t dist2 = pow(fSPPairs[ipair1].x - fSPPairs[ipair2].x,2)
+	  + pow(fSPPairs[ipair1].y - fSPPairs[ipair2].y,2);
+	if(dist2 <= fSpacePointCriterion) {
+	  SpacePointCombo combo = {ipair1, ipair2};
+	  combos.push_back(combo);
+	}
+      }
+    }
+  }
+}
+
 //_____________________________________________________________________________
 // HMS Specific?
 Int_t THcDriftChamber::DestroyPoorSpacePoints()
@@ -1177,6 +1288,12 @@ void THcDriftChamber::LeftRight()
     }
     Int_t nplaneshit = Count1Bits(bitpat);
     //if (fhdebugflagpr) cout << " num of pm = " << nplusminus << " num of hits =" << nhits << endl;
+    // Fit all the combinations at once.  Falls back to FindStub in
+    // the loop if there is no matrix for this plane pattern.
+    Bool_t havestubs = kFALSE;
+    if(nplaneshit >= fNPlanes-2) {
+      havestubs = FindStubs(nhits, sp, plane_list, bitpat, plusminusknown, nplusminus);
+    }
     // Use bit value of integer word to set + or -
     // Loop over all combinations of left right.
     for(Int_t pmloop=0;pmloop<nplusminus;pmloop++) {
@@ -1196,7 +1313,13 @@ void THcDriftChamber::LeftRight()
       }
       if ( (nplaneshit >= fNPlanes-1) || (nplaneshit >= fNPlanes-2 && !fHMSStyleChambers)) {
 	Double_t chi2;
-	chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	if(havestubs) {
+	  chi2 = fLRChi2[pmloop];
+	  for(Int_t i=0;i<3;i++) stub[i] = fLRStub[i][pmloop];
+	  stub[3] = 0.0;
+	} else {
+	  chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	}
 	if (fdebugstubchisq) cout << " pmloop = " << pmloop << " chi2 = " << chi2 << endl;
 	if(chi2 < minchi2) {
 	  if (fStubMaxXPDiff<100. ) {
@@ -1238,7 +1361,14 @@ void THcDriftChamber::LeftRight()
 	}
 	///////////////
       } else if (nplaneshit >= fNPlanes-2 && fHMSStyleChambers) { // Two planes missing
-	Double_t chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	Double_t chi2;
+	if(havestubs) {
+	  chi2 = fLRChi2[pmloop];
+	  for(Int_t i=0;i<3;i++) stub[i] = fLRStub[i][pmloop];
+	  stub[3] = 0.0;
+	} else {
+	  chi2 = FindStub(nhits, sp,plane_list, bitpat, plusminus, stub);
+	}
 	//if(debugging)
 	//if (fhdebugflagpr) cout << "pmloop=" << pmloop << " Chi2=" << chi2 << endl;
 	// Isn't this a bad idea, doing == with reals
@@ -1350,6 +1480,117 @@ Double_t THcDriftChamber::FindStub(Int_t nhits, THcSpacePoint *sp,
   return(chi2);
 }
 
+//_____________________________________________________________________________
+Bool_t THcDriftChamber::FindStubs(Int_t nhits, THcSpacePoint *sp,
+				  Int_t* plane_list, UInt_t bitpat,
+				  Int_t* plusminusknown, Int_t nplusminus)
+{
+  // Same fit as FindStub, for all nplusminus left/right combinations of
+  // the space point at once.  Combination pmloop uses the same signs as
+  // the loop in LeftRight.  Results go to fLRChi2 and fLRStub.
+  //
+  // Each hit can only contribute one of two values to the sums, so these
+  // are computed once per hit.  The combinations are then done kLanes at a
+  // time in fixed size arrays that the compiler can vectorize.  Sums are
+  // made in the same order and with the same operations as FindStub, so
+  // the chi2 and stubs, and with them the left/right choice, are
+  // bit for bit the same.
+  std::map<int,TMatrixD>::const_iterator it = fAA3Inv.find(bitpat);
+  if(it == fAA3Inv.end() || nhits > MAX_HITS_PER_POINT) return kFALSE;
+  const TMatrixD& AA3Inv = it->second;
+  Double_t a[3][3];
+  for(Int_t i=0;i<3;i++) {
+    for(Int_t j=0;j<3;j++) {
+      a[i][j] = AA3Inv(i,j);
+    }
+  }
+
+  // Per hit, for minus (0) and plus (1): dpos/sigma and dpos*coef/sigma
+  Double_t u[MAX_HITS_PER_POINT][2];
+  Double_t t[MAX_HITS_PER_POINT][2][3];
+  Double_t c[MAX_HITS_PER_POINT][3];
+  Int_t    pmbit[MAX_HITS_PER_POINT]; // Bit of pmloop giving the sign, -1 if known
+  Int_t iswhit = 0;
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    Int_t ip = plane_list[ihit];
+    Double_t pos = sp->GetHit(ihit)->GetPos();
+    Double_t dist = sp->GetHitDist(ihit);
+    Double_t dpos[2];
+    dpos[0] = pos + (-1)*dist - fPsi0[ip];
+    dpos[1] = pos + (1)*dist - fPsi0[ip];
+    for(Int_t is=0;is<2;is++) {
+      u[ihit][is] = dpos[is]/fSigma[ip];
+      for(Int_t index=0;index<3;index++) {
+	t[ihit][is][index] = dpos[is]*fStubCoefs[ip][index]/fSigma[ip];
+      }
+    }
+    for(Int_t index=0;index<3;index++) {
+      c[ihit][index] = fStubCoefs[ip][index];
+    }
+    if(plusminusknown[ihit] != 0) {
+      pmbit[ihit] = -1;
+    } else {
+      pmbit[ihit] = iswhit++;
+    }
+  }
+
+  if((Int_t)fLRChi2.size() < nplusminus) {
+    fLRChi2.resize(nplusminus);
+    for(Int_t i=0;i<3;i++) fLRStub[i].resize(nplusminus);
+  }
+
+  const Int_t kLanes = 8;
+  for(Int_t first=0; first<nplusminus; first+=kLanes) {
+    Double_t TT0[kLanes], TT1[kLanes], TT2[kLanes];
+    for(Int_t l=0;l<kLanes;l++) {
+      TT0[l] = TT1[l] = TT2[l] = 0.0;
+    }
+    Int_t sign[MAX_HITS_PER_POINT][kLanes];
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      for(Int_t l=0;l<kLanes;l++) {
+	if(pmbit[ihit] < 0) {
+	  sign[ihit][l] = (plusminusknown[ihit] > 0) ? 1 : 0;
+	} else {
+	  sign[ihit][l] = ((first+l)>>pmbit[ihit]) & 1;
+	}
+      }
+      const Double_t* tm = t[ihit][0];
+      const Double_t* tp = t[ihit][1];
+      for(Int_t l=0;l<kLanes;l++) {
+	Bool_t plus = sign[ihit][l];
+	TT0[l] += plus ? tp[0] : tm[0];
+	TT1[l] += plus ? tp[1] : tm[1];
+	TT2[l] += plus ? tp[2] : tm[2];
+      }
+    }
+    // TT *= AA3Inv, as TVectorD does it
+    Double_t S0[kLanes], S1[kLanes], S2[kLanes], chi2[kLanes];
+    for(Int_t l=0;l<kLanes;l++) {
+      S0[l] = 0; S0[l] += a[0][0]*TT0[l]; S0[l] += a[0][1]*TT1[l]; S0[l] += a[0][2]*TT2[l];
+      S1[l] = 0; S1[l] += a[1][0]*TT0[l]; S1[l] += a[1][1]*TT1[l]; S1[l] += a[1][2]*TT2[l];
+      S2[l] = 0; S2[l] += a[2][0]*TT0[l]; S2[l] += a[2][1]*TT1[l]; S2[l] += a[2][2]*TT2[l];
+      chi2[l] = 0.0;
+    }
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      for(Int_t l=0;l<kLanes;l++) {
+	Double_t r = (sign[ihit][l] ? u[ihit][1] : u[ihit][0])
+	  - c[ihit][0]*S0[l]
+	  - c[ihit][1]*S1[l]
+	  - c[ihit][2]*S2[l];
+	chi2[l] += r*r;
+      }
+    }
+    Int_t nlanes = TMath::Min(kLanes, nplusminus-first);
+    for(Int_t l=0;l<nlanes;l++) {
+      fLRChi2[first+l] = chi2[l];
+      fLRStub[0][first+l] = S0[l];
+      fLRStub[1][first+l] = S1[l];
+      fLRStub[2][first+l] = S2[l];
+    }
+  }
+  return kTRUE;
+}
+
 //_____________________________________________________________________________
 THcDriftChamber::~THcDriftChamber()
 {
@@ -1392,6 +1633,8 @@ void THcDriftChamber::Clear( const Option_t* )
 
   //  fTrackProj->Clear();
   fNhits = 0;
+  fNSpacePoints = 0;
+  fSpacePoints->Clear();
 
 }
 
@@ -51,6 +51,8 @@ public:
   const TClonesArray* GetTrackHits() const { return fTrackProj; }
   TClonesArray* GetSpacePointsP() const { return(fSpacePoints);}
   Int_t GetChamberNum() const { return fChamberNum;}
+  Bool_t GetSpacePointGridCheck() const { return fSpacePointGrid && fSpacePointGridCheck; }
+  Int_t GetNGridMismatch() const { return fNGridMismatch;}
   Double_t GetZPos() const {return fZPos;}
   //  friend class THaScCalib;
   void SetHMSStyleFlag(Int_t flag) {fHMSStyleChambers = flag;}
@@ -128,6 +130,9 @@ protected:
   Double_t   FindStub(Int_t nhits, THcSpacePoint *sp,
 		      Int_t* plane_list, UInt_t bitpat,
 		      Int_t* plusminus, Double_t* stub);
+  Bool_t     FindStubs(Int_t nhits, THcSpacePoint *sp,
+		       Int_t* plane_list, UInt_t bitpat,
+		       Int_t* plusminusknown, Int_t nplusminus);
 
   std::vector<THcDCHit*> fHits;	/* All hits for this chamber */
   TClonesArray *fSpacePoints;
@@ -137,6 +142,34 @@ protected:
   Double_t* stubcoef[4];
   std::map<int,TMatrixD> fAA3Inv;
 
+  // Scratch space of FindHardSpacePoints, kept between events
+  struct SpacePointPair {	// Intersection of two hits
+    THcDCHit* hit1;
+    THcDCHit* hit2;
+    Double_t x, y;
+  };
+  struct SpacePointCombo {	// Two close pairs, indices in fSPPairs
+    Int_t pair1;
+    Int_t pair2;
+  };
+  void       FindSpacePointCombos(std::vector<SpacePointCombo>& combos);
+  void       FindSpacePointCombosGrid(std::vector<SpacePointCombo>& combos);
+  std::vector<SpacePointPair>  fSPPairs;
+  std::vector<SpacePointCombo> fSPCombos;
+  std::vector<SpacePointCombo> fSPCombosCheck;
+  std::vector<Int_t> fGridHead;	// First pair in each cell
+  std::vector<Int_t> fGridNext;	// Next pair in the same cell
+  std::vector<Int_t> fGridCellX;
+  std::vector<Int_t> fGridCellY;
+  std::vector<Int_t> fGridCand;
+  Int_t fSpacePointGrid;	// Use the grid search
+  Int_t fSpacePointGridCheck;	// Also do the full scan and compare
+  Int_t fNGridMismatch;		// Events where grid and scan disagreed
+
+  // Stub fits of all left/right combinations of a space point, from FindStubs
+  std::vector<Double_t> fLRChi2;
+  std::vector<Double_t> fLRStub[3];
+
   THaDetectorBase* fParent;
 
   ClassDef(THcDriftChamber,0)   // A single drift chamber
@@ -391,11 +391,28 @@ Int_t THcDriftChamberPlane::SubtractStartTime()
 {
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for(Int_t ihit=0;ihit<GetNHits();ihit++) { 
+  Int_t nhits = GetNHits();
+  if(!fTTDConv) {
+    for(Int_t ihit=0;ihit<nhits;ihit++) {
+      THcDCHit *thishit = (THcDCHit*) fHits->At(ihit);
+      Double_t temptime= thishit->GetTime()-StartTime;
+      thishit->SetTime(temptime);
+      thishit->ConvertTimeToDist();
+    }
+    return 0;
+  }
+  // All wires of the plane share fTTDConv, so convert the whole plane at once
+  fHitTimes.resize(nhits);
+  fHitDists.resize(nhits);
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
     THcDCHit *thishit = (THcDCHit*) fHits->At(ihit);
     Double_t temptime= thishit->GetTime()-StartTime;
     thishit->SetTime(temptime);
-    thishit->ConvertTimeToDist();
+    fHitTimes[ihit] = temptime;
+  }
+  if(nhits > 0) fTTDConv->ConvertTimeToDist(nhits, &fHitTimes[0], &fHitDists[0]);
+  for(Int_t ihit=0;ihit<nhits;ihit++) {
+    ((THcDCHit*) fHits->At(ihit))->SetDist(fHitDists[ihit]);
   }
   return 0;
 }
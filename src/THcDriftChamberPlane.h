@@ -15,6 +15,7 @@
 #include "THaSubDetector.h"
 #include "TClonesArray.h"
 #include <cassert>
+#include <vector>
 
 class THaEvData;
 class THcDCWire;
@@ -127,6 +128,8 @@ protected:
   virtual Int_t  DefineVariables( EMode mode = kDefine );
 
   THcDCTimeToDistConv* fTTDConv;  // Time-to-distance converter for this plane's wires
+  std::vector<Double_t> fHitTimes; // Scratch for SubtractStartTime
+  std::vector<Double_t> fHitDists;
 
   THcHodoscope* fglHod;		// Hodoscope to get start time
 
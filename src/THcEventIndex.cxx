@@ -0,0 +1,233 @@
+/** \class THcEventIndex
+    \ingroup Base
+
+\brief Byte offset index of the events in a CODA run file
+
+One entry per CODA event, holding its word offset in the file, the EVIO
+block it starts in, its event number and type and, for CODA 3 multi-event
+blocks, the number of physics events it contains.  Event numbers and types
+are taken from the raw event headers (CODA 2 event ID bank, CODA 3 built
+trigger bank), so no crate map or decoder is needed to build the index.
+Non-physics events carry the number of the last physics event before them.
+
+The index is stored in a sidecar file next to the run (see IndexFileName).
+The file records the size and modification time of the run file, and an
+index that does not match the run file is not used.
+
+The index is filled by hcana::Scandalizer on the first replay of a
+THcMmapRun, or by the standalone hcana_index tool.  THcMmapRun uses it to
+seek to an event number or to the next event of a given type.
+
+*/
+#include "THcEventIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace {
+  const char   kIndexMagic[8] = { 'H','C','E','V','I','D','X','\0' };
+  const UInt_t kIndexVersion  = 1;
+
+  struct IndexHeader {
+    char      magic[8];
+    UInt_t    version;
+    UInt_t    entrysize;
+    ULong64_t filesize;		// Size of the run file
+    Long64_t  mtime;		// Modification time of the run file
+    ULong64_t nentries;
+  };
+
+  Bool_t StatRawFile( const char* rawfile, ULong64_t& size, Long64_t& mtime )
+  {
+    struct stat sb;
+    if( stat(rawfile, &sb) != 0 )
+      return kFALSE;
+    size = sb.st_size;
+    mtime = sb.st_mtime;
+    return kTRUE;
+  }
+}
+
+//_____________________________________________________________________________
+THcEventIndex::THcEventIndex() : fNPhysics(0), fLastEvnum(0)
+{
+}
+
+//_____________________________________________________________________________
+THcEventIndex::~THcEventIndex()
+{
+}
+
+//_____________________________________________________________________________
+TString THcEventIndex::IndexFileName( const char* rawfile )
+{
+  return TString(rawfile) + ".idx";
+}
+
+//_____________________________________________________________________________
+void THcEventIndex::Clear()
+{
+  fEntries.clear();
+  fPhysics.clear();
+  fNPhysics = 0;
+  fLastEvnum = 0;
+}
+
+//_____________________________________________________________________________
+void THcEventIndex::AddEvent( const UInt_t* evbuffer, ULong64_t offset,
+			      ULong64_t block, UInt_t evioversion )
+{
+  /// Classify the raw event in evbuffer and append it to the index.
+  /// evioversion 4 means CODA 3 data, lower versions CODA 2.
+
+  Entry entry;
+  entry.offset = offset;
+  entry.block = block;
+  entry.evnum = fLastEvnum;
+  entry.nevents = 0;
+
+  UInt_t len = evbuffer[0] + 1;
+  UInt_t tag = (len > 1) ? evbuffer[1] >> 16 : 0;
+  entry.evtype = tag;
+
+  if( evioversion < 4 ) {
+    // CODA 2: the tag is the event type, physics events start with an
+    // event ID bank holding the event number
+    if( tag >= 1 && tag <= 15 ) {
+      entry.nevents = 1;
+      if( len > 4 )
+	entry.evnum = evbuffer[4];
+    }
+  } else if( tag >= 0xFF50 && tag <= 0xFF8F ) {
+    // CODA 3 physics event: built trigger bank, first segment holds the
+    // 64 bit number of the first event, next segment the 16 bit event types
+    entry.nevents = evbuffer[1] & 0xff;
+    if( len > 6 ) {
+      entry.evnum = evbuffer[5] | (static_cast<ULong64_t>(evbuffer[6]) << 32);
+      UInt_t seglen = evbuffer[4] & 0xffff;
+      UInt_t typeseg = 4 + 1 + seglen;
+      if( typeseg + 1 < len ) {
+	const UShort_t* types = reinterpret_cast<const UShort_t*>(evbuffer + typeseg + 1);
+	entry.evtype = types[0];
+      }
+    }
+  } else if( tag >= 0xFFD0 && tag <= 0xFFD4 ) {
+    // CODA 3 control events: sync, prestart, go, pause, end
+    entry.evtype = 16 + (tag - 0xFFD0);
+  }
+
+  if( entry.nevents > 0 ) {
+    fPhysics.push_back(fEntries.size());
+    fNPhysics += entry.nevents;
+    fLastEvnum = entry.evnum + entry.nevents - 1;
+  }
+  fEntries.push_back(entry);
+}
+
+//_____________________________________________________________________________
+Int_t THcEventIndex::Write( const char* filename, const char* rawfile ) const
+{
+  /// Write the index to filename.  Returns 0 on success.
+
+  IndexHeader hdr;
+  memcpy(hdr.magic, kIndexMagic, sizeof(hdr.magic));
+  hdr.version = kIndexVersion;
+  hdr.entrysize = sizeof(Entry);
+  hdr.nentries = fEntries.size();
+  if( !StatRawFile(rawfile, hdr.filesize, hdr.mtime) )
+    return -1;
+
+  ofstream ofs(filename, ios::binary | ios::trunc);
+  if( !ofs.is_open() )
+    return -1;
+  ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  if( !fEntries.empty() )
+    ofs.write(reinterpret_cast<const char*>(fEntries.data()),
+	      fEntries.size()*sizeof(Entry));
+  return ofs.good() ? 0 : -1;
+}
+
+//_____________________________________________________________________________
+Int_t THcEventIndex::Read( const char* filename, const char* rawfile )
+{
+  /// Read the index from filename.  Returns 0 on success, -1 if there is
+  /// no usable index, -2 if the index is for another version of rawfile.
+
+  Clear();
+  ifstream ifs(filename, ios::binary);
+  if( !ifs.is_open() )
+    return -1;
+  IndexHeader hdr;
+  ifs.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+  if( !ifs.good() || memcmp(hdr.magic, kIndexMagic, sizeof(hdr.magic)) != 0
+      || hdr.version != kIndexVersion || hdr.entrysize != sizeof(Entry) )
+    return -1;
+  ULong64_t filesize;
+  Long64_t mtime;
+  if( !StatRawFile(rawfile, filesize, mtime)
+      || filesize != hdr.filesize || mtime != hdr.mtime )
+    return -2;
+
+  // The entries must fill the rest of the file, do not trust nentries
+  // before allocating them
+  streamoff start = ifs.tellg();
+  ifs.seekg(0, ios::end);
+  streamoff end = ifs.tellg();
+  if( start < 0 || end < start ||
+      hdr.nentries != static_cast<ULong64_t>(end - start)/sizeof(Entry) ||
+      (end - start) % sizeof(Entry) != 0 )
+    return -1;
+  ifs.seekg(start);
+
+  fEntries.resize(hdr.nentries);
+  if( hdr.nentries > 0 )
+    ifs.read(reinterpret_cast<char*>(fEntries.data()), hdr.nentries*sizeof(Entry));
+  if( !ifs.good() ) {
+    Clear();
+    return -1;
+  }
+  for( size_t i = 0; i < fEntries.size(); i++ ) {
+    if( fEntries[i].nevents > 0 ) {
+      fPhysics.push_back(i);
+      fNPhysics += fEntries[i].nevents;
+      fLastEvnum = fEntries[i].evnum + fEntries[i].nevents - 1;
+    }
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+const THcEventIndex::Entry* THcEventIndex::FindEvent( ULong64_t evnum ) const
+{
+  /// Entry holding physics event evnum, 0 if there is none
+
+  // Last physics entry starting at or before evnum
+  auto it = upper_bound(fPhysics.begin(), fPhysics.end(), evnum,
+			[this]( ULong64_t n, UInt_t i ) { return n < fEntries[i].evnum; });
+  if( it == fPhysics.begin() )
+    return 0;
+  const Entry& entry = fEntries[*(--it)];
+  if( evnum >= entry.evnum + entry.nevents )
+    return 0;
+  return &entry;
+}
+
+//_____________________________________________________________________________
+const THcEventIndex::Entry* THcEventIndex::FindNextType( UInt_t evtype, ULong64_t offset ) const
+{
+  /// First entry of type evtype after word offset, 0 if there is none.
+  /// For multi-event blocks only the type of the first event is known.
+
+  auto it = upper_bound(fEntries.begin(), fEntries.end(), offset,
+			[]( ULong64_t off, const Entry& e ) { return off < e.offset; });
+  for( ; it != fEntries.end(); ++it ) {
+    if( it->evtype == evtype )
+      return &(*it);
+  }
+  return 0;
+}
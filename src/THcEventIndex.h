@@ -0,0 +1,48 @@
+#ifndef ROOT_THcEventIndex
+#define ROOT_THcEventIndex
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcEventIndex
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include "TString.h"
+#include <vector>
+
+class THcEventIndex {
+
+ public:
+  struct Entry {		// One CODA event in the file
+    ULong64_t offset;		// Word offset of the event in the file
+    ULong64_t block;		// Word offset of the EVIO block it starts in
+    ULong64_t evnum;		// (First) event number
+    UInt_t    evtype;		// (First) event type
+    UInt_t    nevents;		// Physics events in the event, 0 if not physics
+  };
+
+  THcEventIndex();
+  virtual ~THcEventIndex();
+
+  void          Clear();
+  void          AddEvent( const UInt_t* evbuffer, ULong64_t offset,
+			  ULong64_t block, UInt_t evioversion );
+  Int_t         Write( const char* filename, const char* rawfile ) const;
+  Int_t         Read( const char* filename, const char* rawfile );
+
+  const Entry*  FindEvent( ULong64_t evnum ) const;
+  const Entry*  FindNextType( UInt_t evtype, ULong64_t offset ) const;
+  ULong64_t     GetNPhysics() const { return fNPhysics; }
+  size_t        GetSize() const { return fEntries.size(); }
+  const Entry&  GetEntry( size_t i ) const { return fEntries[i]; }
+
+  static TString IndexFileName( const char* rawfile );
+
+ protected:
+  std::vector<Entry> fEntries;
+  std::vector<UInt_t> fPhysics;	// Entries holding physics events
+  ULong64_t fNPhysics;		// Total number of physics events
+  ULong64_t fLastEvnum;		// Last physics event number seen
+};
+#endif
@@ -95,6 +95,8 @@
 #include "THcShower.h"
 #include "THcHitList.h"
 #include "THcHodoscope.h"
+#include "StageScheduler.h"
+#include "TROOT.h"
 
 #include <vector>
 #include <cstring>
@@ -102,13 +104,17 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <algorithm>
+#include <typeinfo>
 
 using std::vector;
 using namespace std;
 
 //_____________________________________________________________________________
 THcHallCSpectrometer::THcHallCSpectrometer( const char* name, const char* description ) :
-  hcana::ConfigLogging<THaSpectrometer>( name, description ), fPresent(kTRUE)
+  hcana::ConfigLogging<THaSpectrometer>( name, description ), fPresent(kTRUE),
+  fParallelStages(0)
 {
   // Constructor. Defines the standard detectors for the HRS.
   //  AddDetector( new THaTriggerTime("trg","Trigger-based time offset"));
@@ -117,6 +123,10 @@ THcHallCSpectrometer::THcHallCSpectrometer( const char* name, const char* descri
 
   SetTrSorting(kTRUE);
   eventtypes.clear();
+  for(Int_t i=0;i<kNStages;i++) {
+    fStageDone[i] = kFALSE;
+    fStageRet[i] = 0;
+  }
 
   //_logger = spdlog::get("config");
   //if(!_logger) {
@@ -129,6 +139,7 @@ THcHallCSpectrometer::~THcHallCSpectrometer()
 {
   // Destructor
 
+  SetParallelStages(0);
   DefineVariables( kDelete );
 }
 
@@ -143,6 +154,7 @@ Int_t THcHallCSpectrometer::DefineVariables( EMode mode )
   RVarDef vars[] = {
     { "tr.betachisq", "Chi2 of beta", "fTracks.THaTrack.GetBetaChi2()"},
     { "tr.PruneSelect", "Prune Select ID", "fPruneSelect"},
+    { "tr.PruneNRej", "Tracks removed by each prune cut", "fPruneNRej"},
     { "present", "Trigger Type includes this spectrometer", "fPresent"},
     { 0 }
   };
@@ -173,6 +185,7 @@ void THcHallCSpectrometer::InitializeReconstruction()
 {
   fNReconTerms = 0;
   fReconTerms.clear();
+  fReconMatrix.Clear();
   fAngSlope_x = 0.0;
   fAngSlope_y = 0.0;
   fAngOffset_x = 0.0;
@@ -284,6 +297,10 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
 
   // Default values
   fPruneDipoleExit=0;
+  for (Int_t icut = 0; icut < kNPruneCuts; icut++ ) {
+    fPruneNRej[icut] = 0;
+    fPruneNRejTotal[icut] = 0;
+  }
   fSelUsingScin = 0;
   fSelUsingPrune = 0;
   fPruneXp = .2;
@@ -444,6 +461,10 @@ Int_t THcHallCSpectrometer::ReadDatabase( const TDatime& date )
     good = getline(ifile,line).good();
   }
   _spec_logger->info("Read {} matrix element terms", fNReconTerms);
+  fReconMatrix.Clear();
+  for(Int_t iterm=0;iterm<fNReconTerms;iterm++) {
+    fReconMatrix.AddTerm(fReconTerms[iterm].Coeff, fReconTerms[iterm].Exp);
+  }
   if(!good) {
     _spec_logger->error("{} Error processing reconstruction coefficient file {}",here, reconCoeffFilename.c_str());
     return kInitError; // Is this the right return code?
@@ -483,11 +504,29 @@ Int_t THcHallCSpectrometer::FindVertices( TClonesArray& tracks )
 
   fNtracks = tracks.GetLast()+1;
 
+  // Reconstruct all tracks in one pass over the matrix.  A subclass may
+  // override CalculateTargetQuantities, so the batch is only used when
+  // this is a THcHallCSpectrometer itself.
+  Bool_t batch = ( typeid(*this) == typeid(THcHallCSpectrometer) );
+  Double_t hut_rot[fNtracks>0?fNtracks:1][THcReconMatrix::kNVar];
+  Double_t sum[fNtracks>0?fNtracks:1][THcReconMatrix::kNOut];
+  if (batch) {
+    for (Int_t it=0;it<fNtracks;it++) {
+      Double_t xtar=0;
+      FocalPlaneToRecon(static_cast<THaTrack*>( tracks[it] ),xtar,hut_rot[it]);
+    }
+    fReconMatrix.EvalBatch(fNtracks,&hut_rot[0][0],&sum[0][0]);
+  }
+
   for (Int_t it=0;it<tracks.GetLast()+1;it++) {
     THaTrack* track = static_cast<THaTrack*>( tracks[it] );
     Double_t xptar=kBig,yptar=kBig,ytar=kBig,delta=kBig;
-    Double_t xtar=0;
-    CalculateTargetQuantities(track,xtar,xptar,ytar,yptar,delta); 
+    if (batch) {
+      ReconToTarget(sum[it],xptar,ytar,yptar,delta);
+    } else {
+      Double_t xtar=0;
+      CalculateTargetQuantities(track,xtar,xptar,ytar,yptar,delta);
+    }
     // Transfer results to track
     // No beam raster yet
     //; In transport coordinates phi = hyptar = dy/dz and theta = hxptar = dx/dz
@@ -503,6 +542,7 @@ Int_t THcHallCSpectrometer::FindVertices( TClonesArray& tracks )
     track->SetPvect(pvect_temp);
   }
   fPruneSelect=-1.;
+  for (Int_t icut = 0; icut < kNPruneCuts; icut++ ) fPruneNRej[icut] = 0;
   if (fHodo==0 || (( fSelUsingScin == 0 ) && ( fSelUsingPrune == 0 )) ) {
     BestTrackSimple();
   } else if (fHodo!=0 && fSelUsingPrune !=0) {
@@ -525,8 +565,23 @@ void THcHallCSpectrometer::CalculateTargetQuantities(THaTrack* track,Double_t& x
      saturation effects.
   */
 
+  Double_t hut_rot[THcReconMatrix::kNVar];
+  Double_t sum[THcReconMatrix::kNOut];
+
+  FocalPlaneToRecon(track,xtar,hut_rot);
+  // Compute COSY sums
+  fReconMatrix.Eval(hut_rot,sum);
+  ReconToTarget(sum,xptar,ytar,yptar,delta);
+}
+//
+//_____________________________________________________________________________
+void THcHallCSpectrometer::FocalPlaneToRecon(THaTrack* track, Double_t xtar, Double_t* hut_rot)
+{
+  /**
+     Focal plane variables of a track, in the units and rotated frame of
+     the reconstruction matrix.
+  */
   Double_t hut[5];
-  Double_t hut_rot[5];
 
   hut[0] = track->GetX()/100.0 + fZTrueFocus*track->GetTheta() + fDetOffset_x;//m
   hut[1] = track->GetTheta() + fAngOffset_x;//radians
@@ -543,23 +598,16 @@ void THcHallCSpectrometer::CalculateTargetQuantities(THaTrack* track,Double_t& x
   hut_rot[2] = hut[2];
   hut_rot[3] = hut[3] + hut[2]*fAngSlope_y;
   hut_rot[4] = hut[4];
-
-  // Compute COSY sums
-  Double_t sum[4];
-  for(Int_t k=0;k<4;k++) {
-    sum[k] = 0.0;
-  }
-  for(Int_t iterm=0;iterm<fNReconTerms;iterm++) {
-    Double_t term=1.0;
-    for(Int_t j=0;j<5;j++) {
-      if(fReconTerms[iterm].Exp[j]!=0) {
-	term *= pow(hut_rot[j],fReconTerms[iterm].Exp[j]);
-      }
-    }
-    for(Int_t k=0;k<4;k++) {
-      sum[k] += term*fReconTerms[iterm].Coeff[k];
-    }
-  }
+}
+//
+//_____________________________________________________________________________
+void THcHallCSpectrometer::ReconToTarget(const Double_t* sum, Double_t& xptar, Double_t& ytar,
+					 Double_t& yptar, Double_t& delta)
+{
+  /**
+     Target quantities from the COSY sums, with the offsets and the
+     saturation correction.
+  */
   xptar=sum[0] + fPhiOffset;
   ytar=sum[1];
   yptar=sum[2] + fThetaOffset;
@@ -780,277 +828,115 @@ Int_t THcHallCSpectrometer::BestTrackUsingPrune()
      delta, beta, degrees of freedom (of track fit), difference between
      measured beta and beta from p, chisq of beta fit, focal plane time
      and number of PMT hit.
-  */
 
-  Int_t nGood;
-  Double_t chi2Min;
+     The prune variables of all tracks are computed once, and each track
+     gets a bit mask of the cuts it passes and of the cuts it fails.  The
+     cuts are then applied in order: a cut removes the tracks failing it
+     only if at least one remaining track passes it.  The number of
+     tracks removed by each cut is kept in fPruneNRej.
+  */
 
   if ( fNtracks > 0 ) {
-    chi2Min   = 10000000000.0;
+    Double_t chi2Min = 10000000000.0;
     fGoodTrack = 0;
-    vector<bool> keep(fNtracks);
-    vector<Int_t> reject(fNtracks);
 
     THaTrack *testTracks[fNtracks];
+    Double_t chi2PerDeg[fNtracks];
+    UInt_t pass[fNtracks];
+    UInt_t fail[fNtracks];
+    Bool_t keep[fNtracks];
 
-    // ! Initialize all tracks to be good
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      keep[ptrack] = kTRUE;
-      reject[ptrack] = 0;
-      testTracks[ptrack] = static_cast<THaTrack*>( fTracks->At(ptrack) );
-      if (!testTracks[ptrack]) return -1;
-    }
-    fPruneSelect = 0;
-    Double_t PruneSelect=0;
-    // ! Prune on xptar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTTheta() ) < fPruneXp ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if ( nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTTheta() ) >= fPruneXp ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 1;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-    // ! Prune on yptar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTPhi() ) < fPruneYp ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTPhi() ) >= fPruneYp ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 2;
-
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on ytar
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetTY() ) < fPruneYtar ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetTY() ) >= fPruneYtar ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 10;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on delta
-    nGood = 0;
+    Double_t starttime = fHodo->GetStartTimeCenter();
     for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetDp() ) < fPruneDelta ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetDp() ) >= fPruneDelta ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 20;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+      THaTrack* track = static_cast<THaTrack*>( fTracks->At(ptrack) );
+      if (!track) return -1;
+      testTracks[ptrack] = track;
 
-   // !     Prune on dipole exit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t xfp=testTracks[ptrack]->GetX();
-      Double_t yfp=testTracks[ptrack]->GetY();
-      Double_t xpfp=testTracks[ptrack]->GetTheta();
-       Double_t ypfp=testTracks[ptrack]->GetPhi();
-       if ( fPruneDipoleExit==1 && InsideDipoleExitWindow(xfp,xpfp,yfp,ypfp) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t xfp=testTracks[ptrack]->GetX();
-      Double_t yfp=testTracks[ptrack]->GetY();
-      Double_t xpfp=testTracks[ptrack]->GetTheta();
-       Double_t ypfp=testTracks[ptrack]->GetPhi();
-	if (!InsideDipoleExitWindow(xfp,xpfp,yfp,ypfp)  ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 30;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on beta
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      Double_t p = testTracks[ptrack]->GetP();
+      Double_t p = track->GetP();
       Double_t betaP = p / TMath::Sqrt( p * p + fPartMass * fPartMass );
-      if ( ( TMath::Abs( testTracks[ptrack]->GetBeta() - betaP ) < fPruneBeta ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	Double_t p = testTracks[ptrack]->GetP();
-	Double_t betaP = p / TMath::Sqrt( p * p + fPartMass * fPartMass );
-	if ( TMath::Abs( testTracks[ptrack]->GetBeta() - betaP ) >= fPruneBeta ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 100;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on deg. freedom for track chisq
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetNDoF() >= fPruneDf ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetNDoF() < fPruneDf ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 200;
-	}
-      }
-    }
-
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-    //!     Prune on num pmt hits
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetNPMT() >= fPruneNPMT ) && ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetNPMT() < fPruneNPMT ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 100000;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on beta chisqr
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetBetaChi2() < fPruneChiBeta ) &&
-	   ( testTracks[ptrack]->GetBetaChi2() > 0.01 )          &&   ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( ( testTracks[ptrack]->GetBetaChi2() >= fPruneChiBeta ) ||
-	     ( testTracks[ptrack]->GetBetaChi2() <= 0.01          ) ){
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 1000;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on fptime
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( TMath::Abs( testTracks[ptrack]->GetFPTime() - fHodo->GetStartTimeCenter() ) < fPruneFpTime )  &&
-	   ( keep[ptrack] ) ){
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( TMath::Abs( testTracks[ptrack]->GetFPTime() - fHodo->GetStartTimeCenter() ) >= fPruneFpTime ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 2000;
-	}
-      }
+      Double_t val[kNPruneCuts];
+      val[kPruneXp]     = TMath::Abs( track->GetTTheta() );
+      val[kPruneYp]     = TMath::Abs( track->GetTPhi() );
+      val[kPruneYtar]   = TMath::Abs( track->GetTY() );
+      val[kPruneDelta]  = TMath::Abs( track->GetDp() );
+      val[kPruneDipoleExit] =
+	InsideDipoleExitWindow( track->GetX(), track->GetTheta(), track->GetY(), track->GetPhi() );
+      val[kPruneBeta]   = TMath::Abs( track->GetBeta() - betaP );
+      val[kPruneDf]     = track->GetNDoF();
+      val[kPruneNPMT]   = track->GetNPMT();
+      val[kPruneChiBeta] = track->GetBetaChi2();
+      val[kPruneFpTime] = TMath::Abs( track->GetFPTime() - starttime );
+      val[kPruneY2]     = track->GetGoodPlane4();
+      val[kPruneX2]     = track->GetGoodPlane3();
+      chi2PerDeg[ptrack] = track->GetChi2() / track->GetNDoF();
+
+      // Pass and fail are tested separately, so that a NaN neither passes
+      // nor fails a cut
+      UInt_t ok = 0, bad = 0;
+      if ( val[kPruneXp] < fPruneXp )       ok |= 1<<kPruneXp;
+      if ( val[kPruneXp] >= fPruneXp )      bad |= 1<<kPruneXp;
+      if ( val[kPruneYp] < fPruneYp )       ok |= 1<<kPruneYp;
+      if ( val[kPruneYp] >= fPruneYp )      bad |= 1<<kPruneYp;
+      if ( val[kPruneYtar] < fPruneYtar )   ok |= 1<<kPruneYtar;
+      if ( val[kPruneYtar] >= fPruneYtar )  bad |= 1<<kPruneYtar;
+      if ( val[kPruneDelta] < fPruneDelta ) ok |= 1<<kPruneDelta;
+      if ( val[kPruneDelta] >= fPruneDelta ) bad |= 1<<kPruneDelta;
+      if ( fPruneDipoleExit==1 && val[kPruneDipoleExit] != 0 ) ok |= 1<<kPruneDipoleExit;
+      if ( val[kPruneDipoleExit] == 0 )     bad |= 1<<kPruneDipoleExit;
+      if ( val[kPruneBeta] < fPruneBeta )   ok |= 1<<kPruneBeta;
+      if ( val[kPruneBeta] >= fPruneBeta )  bad |= 1<<kPruneBeta;
+      if ( val[kPruneDf] >= fPruneDf )      ok |= 1<<kPruneDf;
+      if ( val[kPruneDf] < fPruneDf )       bad |= 1<<kPruneDf;
+      if ( val[kPruneNPMT] >= fPruneNPMT )  ok |= 1<<kPruneNPMT;
+      if ( val[kPruneNPMT] < fPruneNPMT )   bad |= 1<<kPruneNPMT;
+      if ( val[kPruneChiBeta] < fPruneChiBeta && val[kPruneChiBeta] > 0.01 )
+	ok |= 1<<kPruneChiBeta;
+      if ( val[kPruneChiBeta] >= fPruneChiBeta || val[kPruneChiBeta] <= 0.01 )
+	bad |= 1<<kPruneChiBeta;
+      if ( val[kPruneFpTime] < fPruneFpTime )  ok |= 1<<kPruneFpTime;
+      if ( val[kPruneFpTime] >= fPruneFpTime ) bad |= 1<<kPruneFpTime;
+      if ( val[kPruneY2] == 1 )             ok |= 1<<kPruneY2;
+      else                                  bad |= 1<<kPruneY2;
+      if ( val[kPruneX2] == 1 )             ok |= 1<<kPruneX2;
+      else                                  bad |= 1<<kPruneX2;
+      pass[ptrack] = ok;
+      fail[ptrack] = bad;
+      keep[ptrack] = kTRUE;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
 
-    // !     Prune on Y2 being hit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetGoodPlane4() == 1 )  &&  keep[ptrack] ) {
-	nGood ++;
-      }
-    }
-    if (nGood > 0 ) {
+    fPruneSelect = 0;
+    for (Int_t icut = 0; icut < kNPruneCuts; icut++ ){
+      UInt_t bit = 1<<icut;
+      Int_t nGood = 0;
       for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetGoodPlane4() != 1 ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 10000;
-	}
-      }
-    }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
-
-    // !     Prune on X2 being hit
-    nGood = 0;
-    for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-      if ( ( testTracks[ptrack]->GetGoodPlane3() == 1 )  &&  keep[ptrack] ) {
-	nGood ++;
+	if ( keep[ptrack] && (pass[ptrack] & bit) ) nGood++;
       }
-    }
-    if (nGood > 0 ) {
-      for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-	if ( testTracks[ptrack]->GetGoodPlane3() != 1 ) {
-	  keep[ptrack] = kFALSE;
-	  reject[ptrack] += 20000;
+      if ( nGood > 0 ) {
+	for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
+	  if ( fail[ptrack] & bit ) {
+	    if ( keep[ptrack] ) fPruneNRej[icut]++;
+	    keep[ptrack] = kFALSE;
+	  }
 	}
       }
+      if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=icut+1;
     }
-    PruneSelect++;
-    if (nGood==1 && fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
 
     // !     Pick track with best chisq if more than one track passed prune tests
-    Double_t chi2PerDeg = 0.;
     for (Int_t ptrack = 0; ptrack < fNtracks; ptrack++ ){
-
-      chi2PerDeg =  testTracks[ptrack]->GetChi2() / testTracks[ptrack]->GetNDoF();
-
-      if ( ( chi2PerDeg < chi2Min ) && ( keep[ptrack] ) ){
+      if ( ( chi2PerDeg[ptrack] < chi2Min ) && ( keep[ptrack] ) ){
 	fGoodTrack = ptrack;
-	chi2Min = chi2PerDeg;
+	chi2Min = chi2PerDeg[ptrack];
       }
     }
-     PruneSelect++;
-    if (fPruneSelect ==0 && fNtracks>1) fPruneSelect=PruneSelect;
+    if (fPruneSelect ==0 && fNtracks>1) fPruneSelect=kNPruneCuts+1;
+    for (Int_t icut = 0; icut < kNPruneCuts; icut++ ){
+      fPruneNRejTotal[icut] += fPruneNRej[icut];
+    }
    // Set index=0 for fGoodTrack 
     for (Int_t iitrack = 0; iitrack < fNtracks; iitrack++ ){
-      THaTrack* aTrack = dynamic_cast<THaTrack*>( fTracks->At(iitrack) );
-      aTrack->SetIndex(1);
-      if (iitrack==fGoodTrack) aTrack->SetIndex(0);
+      testTracks[iitrack]->SetIndex(1);
+      if (iitrack==fGoodTrack) testTracks[iitrack]->SetIndex(0);
     }
     //
 
@@ -1060,6 +946,24 @@ Int_t THcHallCSpectrometer::BestTrackUsingPrune()
   return(0);
 }
 
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::End( THaRunBase* run )
+{
+  // Report how many tracks each prune cut removed
+  if (fSelUsingPrune != 0) {
+    static const char* const cutnames[kNPruneCuts] = {
+      "xptar", "yptar", "ytar", "delta", "dipole exit", "beta", "ndof",
+      "npmt", "beta chisq", "fp time", "y2 hit", "x2 hit"
+    };
+    string report;
+    for (Int_t icut = 0; icut < kNPruneCuts; icut++ ) {
+      report += Form(" %s %d", cutnames[icut], fPruneNRejTotal[icut]);
+    }
+    _spec_logger->info("{}: tracks removed by prune cuts:{}", GetName(), report);
+  }
+  return THaSpectrometer::End(run);
+}
+
 //_____________________________________________________________________________
 Int_t THcHallCSpectrometer::TrackTimes( TClonesArray* Tracks ) {
   // Do the actual track-timing (beta) calculation.
@@ -1074,7 +978,16 @@ Int_t THcHallCSpectrometer::TrackTimes( TClonesArray* Tracks ) {
 
 Int_t THcHallCSpectrometer::Decode( const THaEvData& evdata )
 {
+  if(fParallelStages > 0)
+    return RunStage(kStageDecode, &evdata);
 
+  CheckEventType(evdata);
+  return THaSpectrometer::Decode(evdata);
+}
+
+//_____________________________________________________________________________
+void THcHallCSpectrometer::CheckEventType( const THaEvData& evdata )
+{
   fPresent=kTRUE;
   if(eventtypes.size()!=0) {
     Int_t evtype = evdata.GetEvType();
@@ -1082,8 +995,133 @@ Int_t THcHallCSpectrometer::Decode( const THaEvData& evdata )
       fPresent = kFALSE;
     }
   }
+}
 
-  return THaSpectrometer::Decode(evdata);
+//_____________________________________________________________________________
+// Spectrometers that run their stages together, and their thread pool
+static std::vector<THcHallCSpectrometer*> stage_group;
+static std::unique_ptr<hcana::StageScheduler> stage_scheduler;
+
+void THcHallCSpectrometer::SetParallelStages( Int_t nthreads )
+{
+  /**
+     With nthreads > 0 this spectrometer joins the stage group.  The
+     analyzer still calls Decode, CoarseTrack, CoarseReconstruct, Track and
+     Reconstruct of each apparatus in turn, but the first group member
+     called for a stage runs that stage for all members on the shared
+     thread pool, and the other members just return its result.  Decode
+     runs the Decode of every detector of every member in parallel; the
+     later stages run one task per spectrometer, as the detectors of a
+     spectrometer depend on each other there (start time, tracks).  The
+     stage boundaries set by the analyzer keep the dependencies between
+     stages.
+
+     All members of the group must be analyzed for every event.  The pool
+     has the largest nthreads of the group, including the calling thread.
+  */
+  std::vector<THcHallCSpectrometer*>::iterator it =
+    std::find(stage_group.begin(), stage_group.end(), this);
+  if(nthreads <= 0) {
+    fParallelStages = 0;
+    if(it != stage_group.end()) stage_group.erase(it);
+    if(stage_group.empty()) stage_scheduler.reset();
+    return;
+  }
+  if(it == stage_group.end()) stage_group.push_back(this);
+  fParallelStages = nthreads;
+  for(Int_t i=0;i<kNStages;i++) {
+    fStageDone[i] = kFALSE;
+  }
+  if(nthreads > 1) ROOT::EnableThreadSafety();
+  if(!stage_scheduler || stage_scheduler->GetNWorkers()+1 < (size_t)nthreads) {
+    stage_scheduler.reset(new hcana::StageScheduler(nthreads-1));
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::SerialStage( EStage stage )
+{
+  switch(stage) {
+  case kStageCoarseTrack:       return THaSpectrometer::CoarseTrack();
+  case kStageCoarseReconstruct: return THaSpectrometer::CoarseReconstruct();
+  case kStageTrack:             return THaSpectrometer::Track();
+  case kStageReconstruct:       return THaSpectrometer::Reconstruct();
+  default:                      return 0;
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::RunStage( EStage stage, const THaEvData* evdata )
+{
+  /**
+     Run a stage for the whole stage group, unless another member already
+     did it for this event.
+  */
+  if(fStageDone[stage]) {
+    fStageDone[stage] = kFALSE;
+    return fStageRet[stage];
+  }
+  hcana::StageScheduler* sched = stage_scheduler.get();
+  sched->Clear();
+  for(THcHallCSpectrometer* spec : stage_group) {
+    spec->fStageRet[stage] = 0;
+    if(stage == kStageDecode) {
+      // The analyzer may clear the other members only after this Decode
+      if(spec != this) spec->THaSpectrometer::Clear();
+      spec->CheckEventType(*evdata);
+      TIter next(spec->fDetectors);
+      while( THaDetector* det = static_cast<THaDetector*>( next() )) {
+	sched->Add([det,evdata] { det->Decode(*evdata); });
+      }
+    } else {
+      sched->Add([spec,stage] { spec->fStageRet[stage] = spec->SerialStage(stage); });
+    }
+  }
+  sched->Run();
+  for(THcHallCSpectrometer* spec : stage_group) {
+    if(spec != this) spec->fStageDone[stage] = kTRUE;
+  }
+  return fStageRet[stage];
+}
+
+//_____________________________________________________________________________
+void THcHallCSpectrometer::Clear( Option_t* opt )
+{
+  // A group member decoded by another member keeps its event data
+  if(fParallelStages > 0 && fStageDone[kStageDecode]) return;
+  THaSpectrometer::Clear(opt);
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::CoarseTrack()
+{
+  if(fParallelStages > 0)
+    return RunStage(kStageCoarseTrack, 0);
+  return THaSpectrometer::CoarseTrack();
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::CoarseReconstruct()
+{
+  if(fParallelStages > 0)
+    return RunStage(kStageCoarseReconstruct, 0);
+  return THaSpectrometer::CoarseReconstruct();
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::Track()
+{
+  if(fParallelStages > 0)
+    return RunStage(kStageTrack, 0);
+  return THaSpectrometer::Track();
+}
+
+//_____________________________________________________________________________
+Int_t THcHallCSpectrometer::Reconstruct()
+{
+  if(fParallelStages > 0)
+    return RunStage(kStageReconstruct, 0);
+  return THaSpectrometer::Reconstruct();
 }
 
 //_____________________________________________________________________________
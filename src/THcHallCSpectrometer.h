@@ -17,6 +17,7 @@
 #include "THcRawHodoHit.h"
 #include "THcScintillatorPlane.h"
 #include "THcDC.h"
+#include "THcReconMatrix.h"
 
 //#include "THaTrackingDetector.h"
 //#include "THcHitList.h"
@@ -55,8 +56,18 @@ public:
   virtual Int_t   BestTrackUsingScin();
   virtual Int_t   BestTrackUsingPrune();
   virtual Int_t   TrackTimes( TClonesArray* tracks );
+  virtual Int_t   End( THaRunBase* run=0 );
 
   virtual Int_t   Decode( const THaEvData& );
+  virtual void    Clear( Option_t* opt="" );
+  virtual Int_t   CoarseTrack();
+  virtual Int_t   CoarseReconstruct();
+  virtual Int_t   Track();
+  virtual Int_t   Reconstruct();
+
+  // Run the stages of all spectrometers with nthreads > 0 concurrently
+  void    SetParallelStages( Int_t nthreads );
+  Int_t   GetParallelStages() const { return fParallelStages; }
 
   virtual Int_t   ReadRunDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
@@ -80,6 +91,15 @@ public:
 protected:
   void InitializeReconstruction();
 
+  enum EStage { kStageDecode, kStageCoarseTrack, kStageCoarseReconstruct,
+		kStageTrack, kStageReconstruct, kNStages };
+  Int_t   RunStage( EStage stage, const THaEvData* evdata );
+  Int_t   SerialStage( EStage stage );
+  void    CheckEventType( const THaEvData& evdata );
+  Int_t   fParallelStages;		// Threads for the stage group, 0 = serial
+  Bool_t  fStageDone[kNStages];	// Stage already run by another group member
+  Int_t   fStageRet[kNStages];
+
   Bool_t SHMSDipoleExitWindow(Double_t x_dip, Double_t y_dip);
   Bool_t HMSDipoleExitWindow(Double_t x_dip, Double_t y_dip);
   Bool_t fUseSHMSDipoleExitWindow;
@@ -101,6 +121,13 @@ protected:
   Double_t     fSatCorr;
   Double_t     fPruneSelect;
 
+  // Prune cuts, in the order BestTrackUsingPrune applies them
+  enum EPruneCut { kPruneXp, kPruneYp, kPruneYtar, kPruneDelta, kPruneDipoleExit,
+		   kPruneBeta, kPruneDf, kPruneNPMT, kPruneChiBeta, kPruneFpTime,
+		   kPruneY2, kPruneX2, kNPruneCuts };
+  Int_t        fPruneNRej[kNPruneCuts];	     // Tracks removed by each prune cut
+  Int_t        fPruneNRejTotal[kNPruneCuts]; // Same, summed over the run
+
   Int_t        fGoodTrack;
   Int_t        fSelUsingScin;
   Int_t        fSelUsingPrune;
@@ -141,6 +168,10 @@ protected:
     }
   };
   std::vector<reconTerm> fReconTerms;
+  THcReconMatrix fReconMatrix;	//! fReconTerms for evaluation
+  void    FocalPlaneToRecon(THaTrack* track, Double_t xtar, Double_t* hut_rot);
+  void    ReconToTarget(const Double_t* sum, Double_t& xptar, Double_t& ytar,
+			Double_t& yptar, Double_t& delta);
   //  Double_t fReconCoeff[fMaxReconElements][4];
   //  Int_t fReconExponents[fMaxReconElements][5];
   Double_t fAngSlope_x;
@@ -17,11 +17,16 @@
 #include "THcGlobals.h"
 #include "THcParmList.h"
 #include "TList.h"
+#include "TMath.h"
+
+#include <algorithm>
 
 using namespace std;
 
 #define SUPPRESSMISSINGADCREFTIMEMESSAGES 1
-THcHitList::THcHitList() : podd2::HitLogging<podd2::EmptyBase>(), fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE)
+THcHitList::THcHitList() : podd2::HitLogging<podd2::EmptyBase>(),
+  fUseHitIndex(kFALSE), fOrderedInsert(kTRUE), fNHitKeys(0),
+  fMap(0), fTISlot(0), fDisableSlipCorrection(kFALSE)
 {
 
   /// Normal constructor.
@@ -172,18 +177,184 @@ void THcHitList::InitHitList(THaDetMap* detmap,
   fNTDCRef_miss = 0;
   fNADCRef_miss = 0;
 
+  BuildHitIndex();
+  BuildRoutingTable();
+
   //  DisableSlipCorrection();
 }
 
 /**
 
+\brief Build the dense (plane, counter) index of the detector map
+
+Each (plane, counter) that the detector map can produce gets a key.  Keys
+are numbered in (plane, counter) order, so sorting keys sorts hits the same
+way THcRawHit::Compare does.  DecodeToHitList uses the key to find the hit
+list slot of a counter directly instead of searching the hit list.  If the
+map has counters that can not be indexed sensibly (negative or very large
+values), the index is not used and the hit list is searched as before.
+
+*/
+void THcHitList::BuildHitIndex()
+{
+  const Int_t kMaxHitKeys = 100000;
+
+  fUseHitIndex = kFALSE;
+  fNHitKeys = 0;
+  fPlaneKeyOffset.clear();
+  fPlaneCounterMin.clear();
+  fPlaneCounterMax.clear();
+  fKeyPlane.clear();
+  fKeyCounter.clear();
+  fKeySlot.clear();
+  fFiredKeys.clear();
+
+  // Counter range of each plane
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    Int_t plane = d->plane;
+    if(plane >= 1000) continue;	// Reference time definition
+    Int_t cmin = d->first;
+    Int_t cmax = d->first + d->hi - d->lo;
+    if(plane < 0 || cmin < 0) {
+      _hit_logger->warn("BuildHitIndex: plane {} counter {} can not be indexed, using hit list search",
+			plane, cmin);
+      return;
+    }
+    if(plane >= (Int_t) fPlaneKeyOffset.size()) {
+      fPlaneKeyOffset.resize(plane+1, -1);
+      fPlaneCounterMin.resize(plane+1, 0);
+      fPlaneCounterMax.resize(plane+1, -1);
+    }
+    if(fPlaneKeyOffset[plane] < 0) {
+      fPlaneKeyOffset[plane] = 0;
+      fPlaneCounterMin[plane] = cmin;
+      fPlaneCounterMax[plane] = cmax;
+    } else {
+      fPlaneCounterMin[plane] = TMath::Min(fPlaneCounterMin[plane], cmin);
+      fPlaneCounterMax[plane] = TMath::Max(fPlaneCounterMax[plane], cmax);
+    }
+  }
+
+  // Assign keys plane by plane
+  for(Int_t plane=0; plane < (Int_t) fPlaneKeyOffset.size(); plane++) {
+    if(fPlaneKeyOffset[plane] < 0) continue;
+    fPlaneKeyOffset[plane] = fNHitKeys;
+    fNHitKeys += fPlaneCounterMax[plane] - fPlaneCounterMin[plane] + 1;
+    if(fNHitKeys > kMaxHitKeys) {
+      _hit_logger->warn("BuildHitIndex: more than {} counters, using hit list search", kMaxHitKeys);
+      fNHitKeys = 0;
+      return;
+    }
+  }
+
+  fKeyPlane.resize(fNHitKeys);
+  fKeyCounter.resize(fNHitKeys);
+  for(Int_t plane=0; plane < (Int_t) fPlaneKeyOffset.size(); plane++) {
+    if(fPlaneKeyOffset[plane] < 0) continue;
+    for(Int_t counter=fPlaneCounterMin[plane]; counter <= fPlaneCounterMax[plane]; counter++) {
+      Int_t key = GetHitKey(plane, counter);
+      fKeyPlane[key] = plane;
+      fKeyCounter[key] = counter;
+    }
+  }
+  fKeySlot.assign(fNHitKeys, -1);
+  fFiredKeys.reserve(fNHitKeys);
+  fUseHitIndex = kTRUE;
+}
+
+/**
+
+\brief Compile the detector map into a channel routing table
+
+The detector map made by THcDetectorMap::FillMap lists channel ranges of
+modules.  Here it is turned into one entry per module (crate, slot) that
+this detector reads, with a per channel index into a flat list of routes.
+A route holds the plane, counter, signal and reference channel/index that
+the channel feeds, so DecodeToHitList only has to look at the fired
+channels of each module and never has to test channel ranges or work out
+counters.  Channels listed in more than one map entry get chained routes.
+Whether a module is multifunction is filled in at the first event.
+
+*/
+void THcHitList::BuildRoutingTable()
+{
+  fSlotRoutes.clear();
+  fChannelRoutes.clear();
+
+  for (Int_t i=0; i < fdMap->GetSize(); i++) {
+    THaDetMap::Module* d = fdMap->GetModule(i);
+    if(d->plane >= 1000) continue;	// Reference times are handled separately
+
+    // Find or add the entry for this module
+    UInt_t islot=0;
+    while(islot < fSlotRoutes.size()) {
+      if(fSlotRoutes[islot].crate == (Int_t) d->crate
+	 && fSlotRoutes[islot].slot == (Int_t) d->slot) break;
+      islot++;
+    }
+    if(islot == fSlotRoutes.size()) {
+      SlotRoute sr;
+      sr.crate = d->crate;
+      sr.slot = d->slot;
+      sr.multifunction = -1;
+      fSlotRoutes.push_back(sr);
+    }
+    SlotRoute& sr = fSlotRoutes[islot];
+    if((Int_t) sr.chanroute.size() <= (Int_t) d->hi) {
+      sr.chanroute.resize(d->hi+1, -1);
+    }
+
+    for(Int_t chan=d->lo; chan <= (Int_t) d->hi; chan++) {
+      ChannelRoute route;
+      route.crate = d->crate;
+      route.slot = d->slot;
+      route.plane = d->plane;
+      route.counter = d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo;
+      route.signal = d->signal;
+      route.refchan = d->refchan;
+      route.refindex = d->refindex;
+      route.key = fUseHitIndex ? GetHitKey(route.plane, route.counter) : -1;
+      route.next = -1;
+      Int_t iroute = fChannelRoutes.size();
+      fChannelRoutes.push_back(route);
+      // Append to the end of the chain for this channel, keeping map order
+      if(sr.chanroute[chan] < 0) {
+	sr.chanroute[chan] = iroute;
+      } else {
+	Int_t last = sr.chanroute[chan];
+	while(fChannelRoutes[last].next >= 0) last = fChannelRoutes[last].next;
+	fChannelRoutes[last].next = iroute;
+      }
+    }
+  }
+}
+
+/**
+
+\brief Key of (plane, counter) in the dense hit index, -1 if not in the map
+
+*/
+Int_t THcHitList::GetHitKey(Int_t plane, Int_t counter) const
+{
+  if(plane < 0 || plane >= (Int_t) fPlaneKeyOffset.size()) return -1;
+  Int_t offset = fPlaneKeyOffset[plane];
+  if(offset < 0 || counter < fPlaneCounterMin[plane]
+     || counter > fPlaneCounterMax[plane]) return -1;
+  return offset + counter - fPlaneCounterMin[plane];
+}
+
+/**
+
 \brief Populate the hitlist from the raw event data.
 
 Clears the hit list then, finds all populated channels belonging to the detector and add
 sort it into the hitlist.  A given counter in the detector can have
 at most one entry in the hit list.  However, the raw "hit" can contain
 multiple signal types (e.g. ADC+, ADC-, TDC+, TDC-), or multiplehits for multihit tdcs.
-The hit list is sorted (by plane, counter) after filling.
+The hit list is sorted (by plane, counter) after filling.  With the dense
+hit index and ordered insertion, the fired counters are collected first and
+given slots in (plane, counter) order, so no sort is needed afterwards.
 
 */
 Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarnings ) {
@@ -301,152 +472,176 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
     }
   }
 
-  // 
-  for ( Int_t i=0; i < fdMap->GetSize(); i++ ) {
-    THaDetMap::Module* d = fdMap->GetModule(i);
-    
-    // Loop over all channels that have a hit.
-    //    cout << "Crate/Slot: " << d->crate << "/" << d->slot << endl;
-    Int_t plane = d->plane;
-    if (plane >= 1000) continue; // Skip reference times
-    Int_t signal = d->signal;
-    UInt_t signaltype = fSignalTypes[signal];
-    Bool_t multifunction = evdata.IsMultifunction(d->crate, d->slot);
-    // Should probably get the Decoder::Module object and use it's
-    // methods.  Saving a THaEvData::GetModule call every time
-
-    for ( Int_t j=0; j < evdata.GetNumChan( d->crate, d->slot); j++) {
-      THcRawHit* rawhit=0;
-
-      Int_t chan = evdata.GetNextChan( d->crate, d->slot, j );
-      if( chan < d->lo || chan > d->hi ) continue;     // Not one of my channels
-
-      // Need to convert crate, slot, chan into plane, counter, signal
-      // Search hitlist for this plane,counter,signal
-      Int_t counter = d->reverse ? d->first + d->hi - chan : d->first + chan - d->lo;
-      //cout << d->crate << " " << d->slot << " " << chan << " " << plane << " "
-      // << counter << " " << signal << endl;
-      // Search hit list for plane and counter
-      // We could do sorting
-      UInt_t thishit = 0;
-      while(thishit < fNRawHits) {
-	rawhit = (THcRawHit*) (*fRawHitList)[thishit];
-	if (plane == rawhit->fPlane
-	    && counter == rawhit->fCounter) {
-	  // cout << "Found as " << thishit << "/" << fNRawHits << endl;
-	  break;
+  // With the hit index, find all fired counters first and give them
+  // their slots in sorted order
+  Bool_t ordered = fUseHitIndex && fOrderedInsert;
+  Bool_t needsort = kFALSE;
+  Int_t lastkey = -1;
+  if(ordered) {
+    for ( UInt_t islot=0; islot < fSlotRoutes.size(); islot++ ) {
+      const SlotRoute& sr = fSlotRoutes[islot];
+      Int_t nroutechan = sr.chanroute.size();
+      Int_t nchan = evdata.GetNumChan(sr.crate, sr.slot);
+      for ( Int_t j=0; j < nchan; j++) {
+	Int_t chan = evdata.GetNextChan(sr.crate, sr.slot, j);
+	if( chan < 0 || chan >= nroutechan ) continue;     // Not one of my channels
+	for( Int_t iroute=sr.chanroute[chan]; iroute >= 0;
+	     iroute = fChannelRoutes[iroute].next) {
+	  Int_t key = fChannelRoutes[iroute].key;
+	  if(fKeySlot[key] < 0) {
+	    fKeySlot[key] = 0;
+	    fFiredKeys.push_back(key);
+	  }
 	}
-	thishit++;
-      }
-
-      if(thishit == fNRawHits) {
-	rawhit = (THcRawHit*) fRawHitList->ConstructedAt(thishit,"");
-	fNRawHits++;
-	rawhit->fPlane = plane;
-	rawhit->fCounter = counter;
       }
+    }
+    std::sort(fFiredKeys.begin(), fFiredKeys.end());
+    for(UInt_t ihit=0; ihit < fFiredKeys.size(); ihit++) {
+      Int_t key = fFiredKeys[ihit];
+      THcRawHit* rawhit = (THcRawHit*) fRawHitList->ConstructedAt(ihit,"");
+      rawhit->fPlane = fKeyPlane[key];
+      rawhit->fCounter = fKeyCounter[key];
+      fKeySlot[key] = ihit;
+    }
+    fNRawHits = fFiredKeys.size();
+  }
 
-      // Get the data from this channel
-      // Allow for multiple hits
-      if(signaltype == THcRawHit::kTDC || !multifunction) {
-	Int_t nMHits = evdata.GetNumHits(d->crate, d->slot, chan);
-	for (Int_t mhit = 0; mhit < nMHits; mhit++) {
-	  Int_t data = evdata.GetData( d->crate, d->slot, chan, mhit);
-	  // cout << "Signal " << signal << "=" << data << endl;
-	  rawhit->SetData(signal,data);
-	}
-	// Get the reference time.
-	if(d->refchan >= 0) {
-	  Int_t nrefhits = evdata.GetNumHits(d->crate,d->slot,d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime=0;
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(d->crate, d->slot, d->refchan, ihit);
-	    if(reftime >= fTDC_RefTimeCut) {
-	      goodreftime = kTRUE;
+  // Walk the fired channels of each module this detector reads and
+  // route them through the table made in BuildRoutingTable
+  for ( UInt_t islot=0; islot < fSlotRoutes.size(); islot++ ) {
+    SlotRoute& sr = fSlotRoutes[islot];
+    if(sr.multifunction < 0) {	// Module kind is fixed for the run
+      sr.multifunction = evdata.IsMultifunction(sr.crate, sr.slot) ? 1 : 0;
+    }
+    Bool_t multifunction = (sr.multifunction > 0);
+    Int_t nroutechan = sr.chanroute.size();
+
+    Int_t nchan = evdata.GetNumChan(sr.crate, sr.slot);
+    for ( Int_t j=0; j < nchan; j++) {
+      Int_t chan = evdata.GetNextChan(sr.crate, sr.slot, j);
+      if( chan < 0 || chan >= nroutechan ) continue;     // Not one of my channels
+
+      for( Int_t iroute=sr.chanroute[chan]; iroute >= 0;
+	   iroute = fChannelRoutes[iroute].next) {
+	const ChannelRoute* d = &fChannelRoutes[iroute];
+	THcRawHit* rawhit=0;
+	Int_t plane = d->plane;
+	Int_t counter = d->counter;
+	Int_t signal = d->signal;
+	UInt_t signaltype = fSignalTypes[signal];
+
+	if(fUseHitIndex) {
+	  // Look up the slot of this plane and counter in the hit index
+	  Int_t key = d->key;
+	  if(fKeySlot[key] >= 0) {
+	    rawhit = (THcRawHit*) (*fRawHitList)[fKeySlot[key]];
+	  } else {		// Only when not doing ordered insertion
+	    fKeySlot[key] = fNRawHits;
+	    fFiredKeys.push_back(key);
+	    rawhit = (THcRawHit*) fRawHitList->ConstructedAt(fNRawHits,"");
+	    fNRawHits++;
+	    rawhit->fPlane = plane;
+	    rawhit->fCounter = counter;
+	    if(key < lastkey) needsort = kTRUE;
+	    lastkey = key;
+	  }
+	} else {
+	  // Search hit list for plane and counter
+	  UInt_t thishit = 0;
+	  while(thishit < fNRawHits) {
+	    rawhit = (THcRawHit*) (*fRawHitList)[thishit];
+	    if (plane == rawhit->fPlane
+		&& counter == rawhit->fCounter) {
 	      break;
 	    }
+	    thishit++;
 	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
-	      tdcref_miss = kTRUE;
+
+	  if(thishit == fNRawHits) {
+	    rawhit = (THcRawHit*) fRawHitList->ConstructedAt(thishit,"");
+	    fNRawHits++;
+	    rawhit->fPlane = plane;
+	    rawhit->fCounter = counter;
 	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
+	  needsort = kTRUE;
+	}
+
+	// Get the data from this channel
+	// Allow for multiple hits
+	if(signaltype == THcRawHit::kTDC || !multifunction) {
+	  Int_t nMHits = evdata.GetNumHits(d->crate, d->slot, chan);
+	  for (Int_t mhit = 0; mhit < nMHits; mhit++) {
+	    Int_t data = evdata.GetData( d->crate, d->slot, chan, mhit);
+	    // cout << "Signal " << signal << "=" << data << endl;
+	    rawhit->SetData(signal,data);
+	  }
+	  // Get the reference time.
+	  if(d->refchan >= 0) {
+	    Int_t nrefhits = evdata.GetNumHits(d->crate,d->slot,d->refchan);
+	    Bool_t goodreftime=kFALSE;
+	    Int_t reftime=0;
+	    for(Int_t ihit=0; ihit<nrefhits; ihit++) {
+	      reftime = evdata.GetData(d->crate, d->slot, d->refchan, ihit);
+	      if(reftime >= fTDC_RefTimeCut) {
+		goodreftime = kTRUE;
+		break;
+	      }
+	    }
+	    // If RefTimeBest flag set, take the last hit if none of the
+	    // hits make the RefTimeCut
+	    if(goodreftime || (nrefhits>0 && fTDC_RefTimeBest)) {
+	      rawhit->SetReference(signal, reftime);
+	    } else if (!suppresswarnings) {
+	      cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
+		" missing for (" << d->crate << ", " << d->slot <<
+		", " << chan << ")" << endl;
 		tdcref_miss = kTRUE;
+	    }
+	  } else {
+	    if(d->refindex >=0 && d->refindex < fNRefIndex) {
+	      if(fRefIndexMaps[d->refindex].hashit) {
+		rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
+	      } else {
+		if(!suppresswarnings) {
+		  cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
+		    " (" << fRefIndexMaps[d->refindex].crate <<
+		    ", " << fRefIndexMaps[d->refindex].slot <<
+		    ", " << fRefIndexMaps[d->refindex].channel << ")" <<
+		    " missing for (" << d->crate << ", " << d->slot <<
+		    ", " << chan << ")" << endl;
+		  tdcref_miss = kTRUE;
+		}
 	      }
 	    }
 	  }
-	}
-      } else {
-        // This is a Flash ADC
-
-        if (fPSE125) {
-	  if(!fHaveFADCInfo) {
-	    fNSA = fPSE125->GetNSA(d->crate);
-	    fNSB = fPSE125->GetNSB(d->crate);
-	    fNPED = fPSE125->GetNPED(d->crate);
-	    fHaveFADCInfo = kTRUE;
+	} else {
+	  // This is a Flash ADC
+
+	  if (fPSE125) {
+	    if(!fHaveFADCInfo) {
+	      fNSA = fPSE125->GetNSA(d->crate);
+	      fNSB = fPSE125->GetNSB(d->crate);
+	      fNPED = fPSE125->GetNPED(d->crate);
+	      fHaveFADCInfo = kTRUE;
+	    }
+	    // Set F250 parameters.
+	    rawhit->SetF250Params(fNSA, fNSB, fNPED);
 	  }
-	  // Set F250 parameters.
-          rawhit->SetF250Params(fNSA, fNSB, fNPED);
-        }
 	
-	// Copy the samples
-	Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, d->crate, d->slot, chan);
+	  // Copy the samples
+	  Int_t nsamples=evdata.GetNumEvents(Decoder::kSampleADC, d->crate, d->slot, chan);
 
-	// If nsamples comes back zero, may want to suppress further attempts to
-	// get sample data for this or all modules
-	for (Int_t isamp=0;isamp<nsamples;isamp++) {
-	  rawhit->SetSample(signal,evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp));
-	}
-	// Now get the pulse mode data
-	// Pulse area will go into regular SetData, others will use special hit methods
-        Int_t npulses = evdata.GetNumEvents(Decoder::kPulseIntegral, d->crate, d->slot, chan);
-
-        // Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
-	Int_t timeshift=0;
-	if(fTISlot>0) {		// Get the trigger time for this module
-	  if(fTrigTimeShiftMap.find(d->slot)
-	     == fTrigTimeShiftMap.end()) { // 
-	    if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
-	      fTrigTimeShiftMap[d->slot]
-		= fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
-	    }
+	  // If nsamples comes back zero, may want to suppress further attempts to
+	  // get sample data for this or all modules
+	  for (Int_t isamp=0;isamp<nsamples;isamp++) {
+	    rawhit->SetSample(signal,evdata.GetData(Decoder::kSampleADC, d->crate, d->slot, chan, isamp));
 	  }
-	  timeshift = fTrigTimeShiftMap[d->slot];
-	}
-	for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
-          //_hit_logger->debug("event {} : ROC {} slot {} channel {}", evdata.GetEvNum() , d->crate, d->slot, chan);
-	  rawhit->SetDataTimePedestalPeak(signal,
-					  evdata.GetData(Decoder::kPulseIntegral, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, chan, ipulse)+64*timeshift,
-					  evdata.GetData(Decoder::kPulsePedestal, d->crate, d->slot, chan, ipulse),
-					  evdata.GetData(Decoder::kPulsePeak, d->crate, d->slot, chan, ipulse));
-	}
-	// Get the reference time for the FADC pulse time
-	if(d->refchan >= 0) {	// Reference time for the slot
-	  Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseIntegral,
-					       d->crate, d->slot, d->refchan);
-	  Bool_t goodreftime=kFALSE;
-	  Int_t reftime = 0;
-	  timeshift=0;
+	  // Now get the pulse mode data
+	  // Pulse area will go into regular SetData, others will use special hit methods
+	  Int_t npulses = evdata.GetNumEvents(Decoder::kPulseIntegral, d->crate, d->slot, chan);
+
+	  // Assume that the # of pulses for kPulseTime, kPulsePeak and kPulsePedestal are same;
+	  Int_t timeshift=0;
 	  if(fTISlot>0) {		// Get the trigger time for this module
 	    if(fTrigTimeShiftMap.find(d->slot)
 	       == fTrigTimeShiftMap.end()) { // 
@@ -457,41 +652,67 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
 	    }
 	    timeshift = fTrigTimeShiftMap[d->slot];
 	  }
-	  for(Int_t ihit=0; ihit<nrefhits; ihit++) {
-	    reftime = evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, d->refchan, ihit);
-	    reftime += 64*timeshift;
-	    if(reftime >= fADC_RefTimeCut) {
-	      goodreftime=kTRUE;
-	      break;
-	    }
+	  for (Int_t ipulse=0;ipulse<npulses;ipulse++) {
+	    //_hit_logger->debug("event {} : ROC {} slot {} channel {}", evdata.GetEvNum() , d->crate, d->slot, chan);
+	    rawhit->SetDataTimePedestalPeak(signal,
+					    evdata.GetData(Decoder::kPulseIntegral, d->crate, d->slot, chan, ipulse),
+					    evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, chan, ipulse)+64*timeshift,
+					    evdata.GetData(Decoder::kPulsePedestal, d->crate, d->slot, chan, ipulse),
+					    evdata.GetData(Decoder::kPulsePeak, d->crate, d->slot, chan, ipulse));
 	  }
-	  // If RefTimeBest flag set, take the last hit if none of the
-	  // hits make the RefTimeCut
-	  if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
-	    rawhit->SetReference(signal, reftime);
-	  } else if (!suppresswarnings) {
+	  // Get the reference time for the FADC pulse time
+	  if(d->refchan >= 0) {	// Reference time for the slot
+	    Int_t nrefhits = evdata.GetNumEvents(Decoder::kPulseIntegral,
+						 d->crate, d->slot, d->refchan);
+	    Bool_t goodreftime=kFALSE;
+	    Int_t reftime = 0;
+	    timeshift=0;
+	    if(fTISlot>0) {		// Get the trigger time for this module
+	      if(fTrigTimeShiftMap.find(d->slot)
+		 == fTrigTimeShiftMap.end()) { // 
+		if(fFADCSlotMap.find(d->slot) != fFADCSlotMap.end()) {
+		  fTrigTimeShiftMap[d->slot]
+		    = fFADCSlotMap[d->slot]->GetTriggerTime() - titime;
+		}
+	      }
+	      timeshift = fTrigTimeShiftMap[d->slot];
+	    }
+	    for(Int_t ihit=0; ihit<nrefhits; ihit++) {
+	      reftime = evdata.GetData(Decoder::kPulseTime, d->crate, d->slot, d->refchan, ihit);
+	      reftime += 64*timeshift;
+	      if(reftime >= fADC_RefTimeCut) {
+		goodreftime=kTRUE;
+		break;
+	      }
+	    }
+	    // If RefTimeBest flag set, take the last hit if none of the
+	    // hits make the RefTimeCut
+	    if(goodreftime || (nrefhits>0 && fADC_RefTimeBest)) {
+	      rawhit->SetReference(signal, reftime);
+	    } else if (!suppresswarnings) {
 #ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-	    cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
-	      " missing for (" << d->crate << ", " << d->slot <<
-	      ", " << chan << ")" << endl;
+	      cout << "HitList(event=" << evdata.GetEvNum() << "): refchan " << d->refchan <<
+		" missing for (" << d->crate << ", " << d->slot <<
+		", " << chan << ")" << endl;
 #endif
-	      adcref_miss = kTRUE;
-	  }
-	} else {
-	  if(d->refindex >=0 && d->refindex < fNRefIndex) {
-	    if(fRefIndexMaps[d->refindex].hashit) {
-	      rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
-	    } else {
-	      if(!suppresswarnings) {
+		adcref_miss = kTRUE;
+	    }
+	  } else {
+	    if(d->refindex >=0 && d->refindex < fNRefIndex) {
+	      if(fRefIndexMaps[d->refindex].hashit) {
+		rawhit->SetReference(signal, fRefIndexMaps[d->refindex].reftime);
+	      } else {
+		if(!suppresswarnings) {
 #ifndef SUPPRESSMISSINGADCREFTIMEMESSAGES
-		cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
-		  " (" << fRefIndexMaps[d->refindex].crate <<
-		  ", " << fRefIndexMaps[d->refindex].slot <<
-		  ", " << fRefIndexMaps[d->refindex].channel << ")" <<
-		  " missing for (" << d->crate << ", " << d->slot <<
-		  ", " << chan << ")" << endl;
+		  cout << "HitList(event=" << evdata.GetEvNum() << "): refindex " << d->refindex <<
+		    " (" << fRefIndexMaps[d->refindex].crate <<
+		    ", " << fRefIndexMaps[d->refindex].slot <<
+		    ", " << fRefIndexMaps[d->refindex].channel << ")" <<
+		    " missing for (" << d->crate << ", " << d->slot <<
+		    ", " << chan << ")" << endl;
 #endif
-		adcref_miss = kTRUE;
+		  adcref_miss = kTRUE;
+		}
 	      }
 	    }
 	  }
@@ -514,7 +735,13 @@ Int_t THcHitList::DecodeToHitList( const THaEvData& evdata, Bool_t suppresswarni
     }
   }
 #endif    
-  fRawHitList->Sort(fNRawHits);
+  // Hits were added in (plane, counter) order unless needsort is set
+  if(needsort) fRawHitList->Sort(fNRawHits);
+  // Reset the slots of this event's keys for the next event
+  for(UInt_t ihit=0; ihit < fFiredKeys.size(); ihit++) {
+    fKeySlot[fFiredKeys[ihit]] = -1;
+  }
+  fFiredKeys.clear();
 
   fNTDCRef_miss += (tdcref_miss ? 1 : 0);
   fNADCRef_miss += (adcref_miss ? 1 : 0);
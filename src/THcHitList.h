@@ -50,6 +50,16 @@ public:
   void          CreateMissReportParms(const char *prefix);
   void          MissReport(const char *name);
   void          DisableSlipCorrection() {fDisableSlipCorrection = kTRUE;}
+  /** Assign hit list slots in (plane, counter) order while decoding so that
+   * the final sort of the hit list can be skipped.  On by default.
+   */
+  void          SetOrderedInsert(Bool_t ordered=kTRUE) {fOrderedInsert = ordered;}
+  /** Find the hit of a counter with the hit index (default) or by
+   * searching the hit list.  Call after InitHitList; the index is only
+   * used if it could be built.
+   */
+  void          SetUseHitIndex(Bool_t use=kTRUE) {fUseHitIndex = use && fNHitKeys > 0;}
+  Int_t         GetHitKey(Int_t plane, Int_t counter) const;
 
   UInt_t        fNRawHits;
   Int_t         fNMaxRawHits;
@@ -78,6 +88,41 @@ protected:
   // Should this be a sparse list instead in case user
   // picks ridiculously large refindexes?
 
+  void                    BuildHitIndex();
+  void                    BuildRoutingTable();
+
+  // Dense (plane, counter) index, built once from the detector map
+  Bool_t                  fUseHitIndex;     // Index built and usable
+  Bool_t                  fOrderedInsert;   // Assign slots in sorted order
+  Int_t                   fNHitKeys;        // Number of distinct (plane, counter)
+  std::vector<Int_t>      fPlaneKeyOffset;  // First key of each plane, -1 if unused
+  std::vector<Int_t>      fPlaneCounterMin; // Lowest counter of each plane
+  std::vector<Int_t>      fPlaneCounterMax; // Highest counter of each plane
+  std::vector<Int_t>      fKeyPlane;        // Plane of each key
+  std::vector<Int_t>      fKeyCounter;      // Counter of each key
+  std::vector<Int_t>      fKeySlot;         // Hit list slot of each key, -1 if no hit
+  std::vector<Int_t>      fFiredKeys;       // Keys with a hit in the current event
+
+  struct ChannelRoute { // Where one electronics channel goes
+    Int_t crate;
+    Int_t slot;
+    Int_t plane;
+    Int_t counter;
+    Int_t signal;
+    Int_t refchan;
+    Int_t refindex;
+    Int_t key;		// Hit index key, -1 without hit index
+    Int_t next;		// Next route for the same channel, -1 if none
+  };
+  struct SlotRoute { // Channels of one module read by this detector
+    Int_t crate;
+    Int_t slot;
+    Int_t multifunction;	// -1 until known, then 0 or 1
+    std::vector<Int_t> chanroute; // First route of each channel, -1 if not mine
+  };
+  std::vector<SlotRoute>    fSlotRoutes;
+  std::vector<ChannelRoute> fChannelRoutes;
+
   Int_t                   fNRefIndex;
   UInt_t                  fNSignals;
   THcRawHit::ESignalType* fSignalTypes;
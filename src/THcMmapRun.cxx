@@ -0,0 +1,422 @@
+/** \class THcMmapRun
+    \ingroup Base
+
+\brief CODA run read through a memory mapping of the EVIO file
+
+Behaves like THcRun, but Open() maps the whole file read-only and
+ReadEvent() hands out pointers into the mapping, so events are not copied
+into an event buffer.  The CODA file reader of THcRun is not opened for
+a mapped file.  The kernel is told that the file is read sequentially,
+and the part of the file just ahead of the current event is requested
+with MADV_WILLNEED, so repeated replays of a run mostly read from the
+page cache.
+
+EVIO version 4 (CODA 3) events never cross block boundaries and are
+always handed out in place.  In EVIO version 2/3 (CODA 2) files, events
+that cross a block boundary are copied into a local buffer.  Files that
+can not be mapped, are in the other byte order or use another EVIO
+version are read through THcRun as usual.
+
+SkipEvents() skips whole EVIO v4 blocks using the event count in the block
+header, without looking at the events.  With an event index (see
+THcEventIndex and LoadIndex()), SeekToEvent() and SeekToEventType() jump
+directly to an event number or to the next event of a type.
+
+\author Hall C
+
+*/
+#include "THcMmapRun.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const UInt_t kEvioMagic    = 0xc0da0100;
+static const UInt_t kEvioDictBit  = 0x100;  // Block has a dictionary (v4)
+static const UInt_t kEvioLastBit  = 0x200;  // Last block of the file (v4)
+static const size_t kEvioHdrWords = 8;
+static const size_t kAheadWords   = 16*1024*1024; // WILLNEED window, 64 MB
+
+//_____________________________________________________________________________
+THcMmapRun::THcMmapRun( const char* fname, const char* description ) :
+  THcRun(fname, description), fIndex(0)
+{
+  // Normal & default constructor
+
+  InitMapping();
+}
+
+//_____________________________________________________________________________
+THcMmapRun::THcMmapRun( const THcMmapRun& rhs ) :
+  THcRun(rhs), fIndex(0)
+{
+  // Copy ctor.  The mapping and index are not shared; the copy maps the
+  // file when it is opened.
+
+  InitMapping();
+}
+
+//_____________________________________________________________________________
+THcMmapRun::THcMmapRun( const vector<TString>& pathList, const char* filename,
+			const char* description )
+  : THcRun(pathList, filename, description), fIndex(0)
+{
+
+  InitMapping();
+}
+
+//_____________________________________________________________________________
+THcMmapRun& THcMmapRun::operator=(const THaRunBase& rhs)
+{
+  // Assignment operator.  Closes any mapping of this run.
+
+  if (this != &rhs) {
+    UnmapFile();
+    THcRun::operator=(rhs);
+  }
+  return *this;
+}
+
+//_____________________________________________________________________________
+THcMmapRun::~THcMmapRun()
+{
+  // Destructor.
+
+  UnmapFile();
+  delete fIndex;
+}
+
+//_____________________________________________________________________________
+void THcMmapRun::InitMapping()
+{
+  fMapped = kFALSE;
+  fFd = -1;
+  fMap = 0;
+  fMapWords = 0;
+  fAdvised = 0;
+  fEvioVersion = 0;
+  fBlock = fCurBlock = fPos = fBlockEnd = 0;
+  fLastBlock = kFALSE;
+  fEvent = 0;
+  fEventOffset = fEventBlock = 0;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::Open()
+{
+  // Map the data file.  The CODA file reader of THcRun is only opened if
+  // the file can not be mapped; the run is then read with stream reads.
+
+  if( MapFile() == 0 ) {
+    if( fDataVersion <= 0 )
+      fDataVersion = (fEvioVersion == 4) ? 3 : 2;
+    fOpened = kTRUE;
+    return READ_OK;
+  }
+  Int_t st = THcRun::Open();
+  if( st == READ_OK )
+    cout << "THcMmapRun: not mapping " << fFilename
+	 << ", using buffered reads" << endl;
+  return st;
+}
+
+//_____________________________________________________________________________
+Bool_t THcMmapRun::IsOpen() const
+{
+  return fMapped || THcRun::IsOpen();
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::Close()
+{
+  UnmapFile();
+  return THcRun::Close();
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::MapFile()
+{
+  UnmapFile();
+
+  fFd = open(fFilename.Data(), O_RDONLY);
+  if( fFd < 0 )
+    return -1;
+  struct stat sb;
+  if( fstat(fFd, &sb) != 0 ||
+      sb.st_size < (off_t)(kEvioHdrWords*sizeof(UInt_t)) ) {
+    UnmapFile();
+    return -1;
+  }
+  void* addr = mmap(0, sb.st_size, PROT_READ, MAP_PRIVATE, fFd, 0);
+  if( addr == MAP_FAILED ) {
+    UnmapFile();
+    return -1;
+  }
+  fMap = static_cast<const UInt_t*>(addr);
+  fMapWords = sb.st_size/sizeof(UInt_t);
+  madvise(addr, sb.st_size, MADV_SEQUENTIAL);
+
+  // Only native byte order EVIO v2-v4 is read in place
+  fEvioVersion = fMap[5] & 0xff;
+  if( fMap[7] != kEvioMagic || fEvioVersion < 2 || fEvioVersion > 4 ) {
+    UnmapFile();
+    return -1;
+  }
+
+  fBlock = fPos = fBlockEnd = 0;
+  fLastBlock = kFALSE;
+  fAdvised = 0;
+  AdviseAhead();
+  fMapped = kTRUE;
+  return 0;
+}
+
+//_____________________________________________________________________________
+void THcMmapRun::UnmapFile()
+{
+  if( fMap )
+    munmap(const_cast<UInt_t*>(fMap), fMapWords*sizeof(UInt_t));
+  if( fFd >= 0 )
+    close(fFd);
+  InitMapping();
+}
+
+//_____________________________________________________________________________
+void THcMmapRun::AdviseAhead()
+{
+  // Ask for the next part of the file once half of the window is used
+
+  if( fAdvised >= fMapWords || fPos + kAheadWords/2 < fAdvised )
+    return;
+  size_t pagewords = sysconf(_SC_PAGESIZE)/sizeof(UInt_t);
+  size_t from = (fAdvised/pagewords)*pagewords;
+  size_t to = min(fMapWords, fPos + kAheadWords);
+  madvise(const_cast<UInt_t*>(fMap + from), (to - from)*sizeof(UInt_t),
+	  MADV_WILLNEED);
+  fAdvised = to;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::NextBlock()
+{
+  // Move to the block starting at fBlock.  A missing or truncated block at
+  // the end of the file is treated as end of file, so files that are still
+  // being written can be read.
+
+  if( fLastBlock || fBlock + kEvioHdrWords > fMapWords )
+    return READ_EOF;
+  const UInt_t* hdr = fMap + fBlock;
+  if( hdr[7] != kEvioMagic ) {
+    cout << "THcMmapRun: bad EVIO block header at word " << fBlock << endl;
+    return READ_FATAL;
+  }
+  size_t blocklen = hdr[0];
+  size_t hdrlen = hdr[2];
+  if( hdrlen < kEvioHdrWords || blocklen < hdrlen ) {
+    cout << "THcMmapRun: bad EVIO block length at word " << fBlock << endl;
+    return READ_FATAL;
+  }
+  if( fBlock + blocklen > fMapWords )
+    return READ_EOF;
+
+  fCurBlock = fBlock;
+  fPos = fBlock + hdrlen;
+  if( fEvioVersion == 4 ) {
+    fBlockEnd = fBlock + blocklen;
+    if( fBlock == 0 && (hdr[5] & kEvioDictBit) )
+      fPos += fMap[fPos] + 1;	// Skip the dictionary
+    fLastBlock = (hdr[5] & kEvioLastBit) != 0;
+  } else {
+    fBlockEnd = fBlock + min(blocklen, (size_t)hdr[4]); // Used words
+  }
+  fBlock += blocklen;
+  return READ_OK;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::ReadEventV4()
+{
+  // EVIO v4: events are whole banks inside a block
+
+  while( fPos >= fBlockEnd ) {
+    Int_t st = NextBlock();
+    if( st != READ_OK )
+      return st;
+  }
+  fEventOffset = fPos;
+  fEventBlock = fCurBlock;
+  const UInt_t* ev = fMap + fPos;
+  size_t len = ev[0] + 1;
+  if( fPos + len > fBlockEnd ) {
+    cout << "THcMmapRun: event overruns its block at word " << fPos << endl;
+    return READ_FATAL;
+  }
+  fEvent = ev;
+  fPos += len;
+  return READ_OK;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::ReadEventV2()
+{
+  // EVIO v2/v3: events are a stream that continues across block headers
+
+  while( fPos >= fBlockEnd ) {
+    Int_t st = NextBlock();
+    if( st != READ_OK )
+      return st;
+  }
+  fEventOffset = fPos;
+  fEventBlock = fCurBlock;
+  const UInt_t* ev = fMap + fPos;
+  size_t len = ev[0] + 1;
+  if( fPos + len <= fBlockEnd ) {
+    fEvent = ev;
+    fPos += len;
+    return READ_OK;
+  }
+  // Event continues in the next block(s).  Stitch it together.
+  fSpanBuffer.resize(len);
+  size_t got = 0;
+  while( got < len ) {
+    if( fPos >= fBlockEnd ) {
+      Int_t st = NextBlock();
+      if( st != READ_OK )
+	return st;
+    }
+    size_t n = min(len - got, fBlockEnd - fPos);
+    memcpy(&fSpanBuffer[got], fMap + fPos, n*sizeof(UInt_t));
+    got += n;
+    fPos += n;
+  }
+  fEvent = fSpanBuffer.data();
+  return READ_OK;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::ReadEvent()
+{
+  if( !fMapped )
+    return THcRun::ReadEvent();
+  Int_t st = (fEvioVersion == 4) ? ReadEventV4() : ReadEventV2();
+  if( st == READ_OK )
+    AdviseAhead();
+  return st;
+}
+
+//_____________________________________________________________________________
+const UInt_t* THcMmapRun::GetEvBuffer() const
+{
+  return fMapped ? fEvent : THcRun::GetEvBuffer();
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::SkipEvents( Int_t nskip )
+{
+  // Skip up to nskip events, stopping at end of file.  Returns the number
+  // of events skipped.  Whole EVIO v4 blocks are skipped by their header.
+
+  Int_t skipped = 0;
+  while( skipped < nskip ) {
+    if( fMapped && fEvioVersion == 4 && fPos >= fBlockEnd
+	&& fBlock + kEvioHdrWords <= fMapWords && !fLastBlock ) {
+      const UInt_t* hdr = fMap + fBlock;
+      size_t blocklen = hdr[0];
+      if( hdr[7] == kEvioMagic && hdr[2] >= kEvioHdrWords && blocklen >= hdr[2]
+	  && fBlock + blocklen <= fMapWords
+	  && !(hdr[5] & (kEvioDictBit | kEvioLastBit))
+	  && (Int_t)hdr[3] <= nskip - skipped ) {
+	skipped += hdr[3];
+	fBlock += blocklen;
+	continue;
+      }
+    }
+    if( ReadEvent() != READ_OK )
+      break;
+    skipped++;
+  }
+  if( fMapped ) {
+    if( fPos >= fBlockEnd )	// Continue at the next block
+      fPos = fBlockEnd = fBlock;
+    fAdvised = fPos;
+    AdviseAhead();
+  }
+  return skipped;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::SeekTo( ULong64_t offset, ULong64_t block )
+{
+  // Position the run so that the next ReadEvent() returns the event at
+  // word offset, which starts in the block at word offset block.
+
+  if( !fMapped )
+    return -1;
+  fBlock = block;
+  fLastBlock = kFALSE;
+  if( NextBlock() != READ_OK || offset < fPos || offset >= fBlockEnd ) {
+    cout << "THcMmapRun: can not seek to word " << offset << endl;
+    return -1;
+  }
+  fPos = offset;
+  fAdvised = fPos;
+  AdviseAhead();
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::LoadIndex()
+{
+  // Read the event index of this run from its sidecar file.  Returns 0 if
+  // a usable index was found.
+
+  if( !fIndex )
+    fIndex = new THcEventIndex;
+  Int_t st = fIndex->Read(THcEventIndex::IndexFileName(fFilename), fFilename);
+  if( st == -2 )
+    cout << "THcMmapRun: event index of " << fFilename
+	 << " is out of date, not using it" << endl;
+  if( st != 0 ) {
+    delete fIndex;
+    fIndex = 0;
+  }
+  return st;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::SeekToEvent( ULong64_t evnum )
+{
+  // Seek to the CODA event holding physics event evnum.  Returns the
+  // position of evnum inside a multi-event block (0 for single events),
+  // or -1 if the event can not be found.
+
+  if( !fIndex && LoadIndex() != 0 )
+    return -1;
+  const THcEventIndex::Entry* entry = fIndex->FindEvent(evnum);
+  if( !entry || SeekTo(entry->offset, entry->block) != 0 )
+    return -1;
+  return evnum - entry->evnum;
+}
+
+//_____________________________________________________________________________
+Int_t THcMmapRun::SeekToEventType( UInt_t evtype )
+{
+  // Seek to the next event of type evtype after the current one.  Returns
+  // -1 if there is none.
+
+  if( !fIndex && LoadIndex() != 0 )
+    return -1;
+  ULong64_t after = fEvent ? fEventOffset : 0;
+  const THcEventIndex::Entry* entry = fIndex->FindNextType(evtype, after);
+  if( !entry )
+    return -1;
+  return SeekTo(entry->offset, entry->block);
+}
+
+ClassImp(THcMmapRun)
@@ -0,0 +1,73 @@
+#ifndef ROOT_THcMmapRun
+#define ROOT_THcMmapRun
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcMmapRun
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "THcRun.h"
+#include "THcEventIndex.h"
+#include <vector>
+
+class THcMmapRun : public THcRun {
+
+ public:
+  THcMmapRun( const char* filename="", const char* description="" );
+  THcMmapRun( const THcMmapRun& run );
+  THcMmapRun( const std::vector<TString>& pathList, const char* filename,
+	      const char* description="" );
+  THcMmapRun& operator=( const THaRunBase& rhs );
+  virtual ~THcMmapRun();
+
+  virtual Int_t         Open();
+  virtual Int_t         Close();
+  virtual Bool_t        IsOpen() const;
+  virtual Int_t         ReadEvent();
+  virtual const UInt_t* GetEvBuffer() const;
+
+  Int_t         SkipEvents( Int_t nskip );
+  Bool_t        IsMapped() const { return fMapped; }
+  UInt_t        GetEvioVersion() const { return fEvioVersion; }
+  ULong64_t     GetEventOffset() const { return fEventOffset; }
+  ULong64_t     GetEventBlock() const { return fEventBlock; }
+
+  // Random access through the event index
+  Int_t         SeekTo( ULong64_t offset, ULong64_t block );
+  Int_t         LoadIndex();
+  THcEventIndex* GetIndex() const { return fIndex; }
+  Int_t         SeekToEvent( ULong64_t evnum );
+  Int_t         SeekToEventType( UInt_t evtype );
+
+ protected:
+  Int_t         MapFile();
+  void          UnmapFile();
+  Int_t         NextBlock();
+  Int_t         ReadEventV4();
+  Int_t         ReadEventV2();
+  void          AdviseAhead();
+
+  Bool_t              fMapped;      // File is mapped and read from memory
+  Int_t               fFd;          // Descriptor of the mapped file
+  const UInt_t*       fMap;         //! Start of the mapping
+  size_t              fMapWords;    // Length of the mapping in words
+  size_t              fAdvised;     // Words up to which WILLNEED was given
+  UInt_t              fEvioVersion; // EVIO format version of the file
+  size_t              fBlock;       // Word offset of the next block header
+  size_t              fCurBlock;    // Word offset of the current block header
+  size_t              fPos;         // Word offset of the next event
+  size_t              fBlockEnd;    // Word offset of the end of current block data
+  Bool_t              fLastBlock;   // Current block is flagged as the last one
+  const UInt_t*       fEvent;       //! Current event
+  ULong64_t           fEventOffset; // Word offset of the current event
+  ULong64_t           fEventBlock;  // Block the current event starts in
+  std::vector<UInt_t> fSpanBuffer;  // Copy of an event spanning blocks (EVIO v2/v3)
+  THcEventIndex*      fIndex;       //! Event index of the file, if loaded
+
+ private:
+  void          InitMapping();
+
+  ClassDef(THcMmapRun,0);
+};
+#endif
@@ -0,0 +1,218 @@
+/** \class THcRNTupleOutput
+    \ingroup Base
+
+\brief THaOutput that also writes the event tree variables as an RNTuple
+
+Takes the same output.def as THaOutput and fills the same "T" tree.  On
+the first event, after the detectors have added their ManualInitTree
+branches, the top level branches of the tree are mapped onto the fields of
+an RNTuple that is written into the same file:
+
+- Double_t variables become double fields bound to the tree buffers,
+- variable and fixed size Double_t arrays become std::vector<double>
+  fields, and their "Ndata." count branches are dropped,
+- object branches such as the hallc::data structs become class fields.
+
+RNTuple field names cannot contain '.', so "P.gtr.dp" is written as
+"P_gtr_dp" (see FieldName).  Branches of other types are skipped with a
+warning.
+
+Pages are compressed in parallel when ROOT implicit multithreading is on;
+SetCompressionThreads(n) turns it on with n threads.  SetClusterSize sets
+the approximate compressed cluster size.  The tree must not switch to a
+new file during the run.
+
+Install it with THcAnalyzer::SetOutput before the analyzer is initialized.
+Needs ROOT 6.34 or later; with older versions only the tree is written.
+
+*/
+#include "THcRNTupleOutput.h"
+
+#include "TTree.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TBranchElement.h"
+#include "TROOT.h"
+#include "TError.h"
+
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,34,0)
+#define HCANA_HAVE_RNTUPLE
+#include <ROOT/REntry.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+namespace rntuple = ROOT;
+#else
+namespace rntuple = ROOT::Experimental;
+#endif
+#endif
+
+using namespace std;
+
+#ifdef HCANA_HAVE_RNTUPLE
+struct THcRNTupleOutput::Sink {
+  struct Array {		// A Double_t array branch
+    string          fField;
+    TLeaf*          fLeaf;	// Its buffer can move when the array grows
+    TLeaf*          fCount;	// Count leaf, 0 for fixed size
+    Int_t           fLen;	// Size if fixed
+    vector<double>  fValues;
+  };
+  struct Raw {			// A field bound to the tree buffer
+    string fField;
+    void*  fAddr;
+  };
+  vector<Raw>   fRaw;
+  vector<Array> fArrays;
+  unique_ptr<rntuple::RNTupleWriter> fWriter;
+  unique_ptr<rntuple::REntry>        fEntry;
+};
+#else
+struct THcRNTupleOutput::Sink {};
+#endif
+
+//_____________________________________________________________________________
+THcRNTupleOutput::THcRNTupleOutput( const char* ntuplename ) :
+  THaOutput(), fNTupleName(ntuplename), fClusterSize(0), fNThreads(0),
+  fSink(0)
+{
+}
+
+//_____________________________________________________________________________
+THcRNTupleOutput::~THcRNTupleOutput()
+{
+  delete fSink;
+}
+
+//_____________________________________________________________________________
+TString THcRNTupleOutput::FieldName( const char* branchname )
+{
+  // RNTuple field name of a tree branch: characters other than letters,
+  // digits and '_' are replaced by '_'.
+  TString name(branchname);
+  for( Ssiz_t i = 0; i < name.Length(); i++ ) {
+    if( !isalnum(name[i]) && name[i] != '_' )
+      name[i] = '_';
+  }
+  return name;
+}
+
+//_____________________________________________________________________________
+Int_t THcRNTupleOutput::BookNTuple()
+{
+  // Create the RNTuple model from the top level branches of the tree and
+  // open the writer in the tree's file.
+  static const char* const here = "THcRNTupleOutput::BookNTuple";
+
+  fSink = new Sink;
+#ifdef HCANA_HAVE_RNTUPLE
+  TTree* tree = GetTree();
+  TFile* file = tree ? tree->GetCurrentFile() : 0;
+  if( !file ) {
+    ::Error( here, "No output tree or file" );
+    return -1;
+  }
+  auto model = rntuple::RNTupleModel::CreateBare();
+
+  TIter next(tree->GetListOfBranches());
+  while( TBranch* br = static_cast<TBranch*>(next()) ) {
+    string field = FieldName(br->GetName()).Data();
+    if( br->InheritsFrom(TBranchElement::Class()) ) {
+      TBranchElement* bre = static_cast<TBranchElement*>(br);
+      auto res = rntuple::RFieldBase::Create(field, bre->GetClassName());
+      if( !res || !bre->GetObject() ) {
+	::Warning( here, "Skipping branch %s of class %s", br->GetName(),
+		   bre->GetClassName() );
+	continue;
+      }
+      model->AddField(res.Unwrap());
+      fSink->fRaw.push_back({field, bre->GetObject()});
+      continue;
+    }
+    TLeaf* leaf = static_cast<TLeaf*>(br->GetListOfLeaves()->At(0));
+    if( !leaf || leaf->IsRange() )	// Array counts are implicit
+      continue;
+    if( br->GetListOfLeaves()->GetEntries() != 1 ||
+	strcmp(leaf->GetTypeName(), "Double_t") != 0 ) {
+      ::Warning( here, "Skipping branch %s", br->GetName() );
+      continue;
+    }
+    if( leaf->GetLeafCount() || leaf->GetLen() > 1 ) {
+      model->MakeField<vector<double>>(field);
+      fSink->fArrays.push_back({field, leaf, leaf->GetLeafCount(),
+	    leaf->GetLen(), vector<double>()});
+    } else {
+      model->MakeField<double>(field);
+      fSink->fRaw.push_back({field, leaf->GetValuePointer()});
+    }
+  }
+
+  rntuple::RNTupleWriteOptions options;
+  if( fClusterSize > 0 )
+    options.SetApproxZippedClusterSize(fClusterSize);
+  if( fNThreads > 0 && !ROOT::IsImplicitMTEnabled() )
+    ROOT::EnableImplicitMT(fNThreads);
+
+  TDirectory::TContext ctx(file);
+  fSink->fWriter = rntuple::RNTupleWriter::Append(std::move(model),
+						  fNTupleName.Data(), *file, options);
+  fSink->fEntry = fSink->fWriter->GetModel().CreateBareEntry();
+  for( auto& r : fSink->fRaw )
+    fSink->fEntry->BindRawPtr(r.fField, r.fAddr);
+  // fArrays is complete, so the vectors do not move any more
+  for( auto& a : fSink->fArrays )
+    fSink->fEntry->BindRawPtr(a.fField, &a.fValues);
+  return 0;
+#else
+  ::Error( here, "RNTuple output needs ROOT 6.34 or later" );
+  return -1;
+#endif
+}
+
+//_____________________________________________________________________________
+Int_t THcRNTupleOutput::Process()
+{
+  // Fill the tree, then the RNTuple from the same buffers.
+  Int_t status = THaOutput::Process();
+  if( status != 0 )
+    return status;
+  if( !fSink )
+    BookNTuple();		// On failure only the tree is written
+#ifdef HCANA_HAVE_RNTUPLE
+  if( !fSink->fWriter )
+    return 0;
+  for( auto& a : fSink->fArrays ) {
+    // THaOdata reallocates a growing array and resets the branch address,
+    // so the buffer is looked up for every event
+    const Double_t* data = static_cast<const Double_t*>(a.fLeaf->GetValuePointer());
+    Int_t n = a.fCount ? static_cast<Int_t>(a.fCount->GetValue()) : a.fLen;
+    a.fValues.assign(data, data + n);
+  }
+  fSink->fWriter->Fill(*fSink->fEntry);
+#endif
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t THcRNTupleOutput::End()
+{
+  // Commit the RNTuple, then write the tree as THaOutput does.
+  if( fSink ) {
+#ifdef HCANA_HAVE_RNTUPLE
+    fSink->fEntry.reset();
+    fSink->fWriter.reset();
+#endif
+    delete fSink;
+    fSink = 0;
+  }
+  return THaOutput::End();
+}
+
+ClassImp(THcRNTupleOutput)
@@ -0,0 +1,44 @@
+#ifndef ROOT_THcRNTupleOutput
+#define ROOT_THcRNTupleOutput
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcRNTupleOutput
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "THaOutput.h"
+#include "TString.h"
+
+class THcRNTupleOutput : public THaOutput {
+
+ public:
+  THcRNTupleOutput( const char* ntuplename = "N" );
+  virtual ~THcRNTupleOutput();
+
+  virtual Int_t Process();
+  virtual Int_t End();
+
+  // Approximate compressed size of one RNTuple cluster, 0 = ROOT default
+  void     SetClusterSize( Long64_t bytes ) { fClusterSize = bytes; }
+  Long64_t GetClusterSize() const { return fClusterSize; }
+  // Threads for page compression, 0 = whatever implicit MT is enabled
+  void     SetCompressionThreads( Int_t nthreads ) { fNThreads = nthreads; }
+  Int_t    GetCompressionThreads() const { return fNThreads; }
+
+  const char* GetNTupleName() const { return fNTupleName.Data(); }
+  static TString FieldName( const char* branchname );
+
+ protected:
+  Int_t  BookNTuple();
+
+  struct Sink;
+  TString  fNTupleName;		// Name of the RNTuple in the output file
+  Long64_t fClusterSize;
+  Int_t    fNThreads;
+  Sink*    fSink;		//! Writer and the column bindings
+
+  ClassDef(THcRNTupleOutput,0)	// Output tree variables also written as an RNTuple
+};
+
+#endif
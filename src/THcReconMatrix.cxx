@@ -0,0 +1,111 @@
+/** \class THcReconMatrix
+    \ingroup DetSupport
+
+\brief COSY reconstruction matrix used by THcHallCSpectrometer
+
+Each term is coeff[k] * x0^e0 * x1^e1 * x2^e2 * x3^e3 * x4^e4 for the
+outputs k = xptar, ytar, yptar, delta.  The reconstruction matrix files
+give each exponent as one digit, so the powers of each variable up to
+the highest exponent in the matrix are computed first, with pow() as in
+the old term loop, and every term is then a product of table entries.
+Factors with exponent 0 are 1.0 and the factors are multiplied in the
+same order, so the sums are the same as the old loop.
+
+*/
+#include "THcReconMatrix.h"
+#include <cmath>
+
+//_____________________________________________________________________________
+void THcReconMatrix::Clear()
+{
+  fNTerms = 0;
+  for(Int_t j=0;j<kNVar;j++) {
+    fExp[j].clear();
+    fMaxExp[j] = 0;
+  }
+  for(Int_t k=0;k<kNOut;k++) {
+    fCoeff[k].clear();
+  }
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::AddTerm(const Double_t* coeff, const Int_t* exp)
+{
+  // Exponents outside 0..kMaxExp can not come from the %1d matrix format
+  // and are set to 0.
+  for(Int_t j=0;j<kNVar;j++) {
+    Int_t e = (exp[j] >= 0 && exp[j] <= kMaxExp) ? exp[j] : 0;
+    fExp[j].push_back(e);
+    if(e > fMaxExp[j]) fMaxExp[j] = e;
+  }
+  for(Int_t k=0;k<kNOut;k++) {
+    fCoeff[k].push_back(coeff[k]);
+  }
+  fNTerms++;
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::Eval(const Double_t* x, Double_t* sum) const
+{
+  // Target quantities sum[kNOut] of one track with focal plane
+  // variables x[kNVar]
+  Double_t pw[kNVar][kMaxExp+1];
+  for(Int_t j=0;j<kNVar;j++) {
+    pw[j][0] = 1.0;
+    for(Int_t e=1;e<=fMaxExp[j];e++) {
+      pw[j][e] = pow(x[j],e);
+    }
+  }
+  for(Int_t k=0;k<kNOut;k++) {
+    sum[k] = 0.0;
+  }
+  for(Int_t iterm=0;iterm<fNTerms;iterm++) {
+    Double_t term = 1.0;
+    for(Int_t j=0;j<kNVar;j++) {
+      term *= pw[j][fExp[j][iterm]];
+    }
+    for(Int_t k=0;k<kNOut;k++) {
+      sum[k] += term*fCoeff[k][iterm];
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THcReconMatrix::EvalBatch(Int_t n, const Double_t* x, Double_t* sum)
+{
+  // Target quantities of n tracks.  x[i*kNVar+j] is variable j of track i,
+  // and sum[i*kNOut+k] output k.  Same results as Eval for each track.
+  if(n <= 0) return;
+  // Power table, pow[(j*(kMaxExp+1)+e)*n+i] = x_j^e of track i
+  fPow.resize(kNVar*(kMaxExp+1)*n);
+  for(Int_t j=0;j<kNVar;j++) {
+    Double_t* p0 = &fPow[(j*(kMaxExp+1))*n];
+    for(Int_t i=0;i<n;i++) p0[i] = 1.0;
+    for(Int_t e=1;e<=fMaxExp[j];e++) {
+      Double_t* pe = &fPow[(j*(kMaxExp+1)+e)*n];
+      for(Int_t i=0;i<n;i++) pe[i] = pow(x[i*kNVar+j],e);
+    }
+  }
+  Double_t out[kNOut][n];
+  for(Int_t k=0;k<kNOut;k++) {
+    for(Int_t i=0;i<n;i++) out[k][i] = 0.0;
+  }
+  for(Int_t iterm=0;iterm<fNTerms;iterm++) {
+    const Double_t* p[kNVar];
+    for(Int_t j=0;j<kNVar;j++) {
+      p[j] = &fPow[(j*(kMaxExp+1)+fExp[j][iterm])*n];
+    }
+    Double_t c0 = fCoeff[0][iterm], c1 = fCoeff[1][iterm];
+    Double_t c2 = fCoeff[2][iterm], c3 = fCoeff[3][iterm];
+    for(Int_t i=0;i<n;i++) {
+      Double_t term = 1.0*p[0][i]*p[1][i]*p[2][i]*p[3][i]*p[4][i];
+      out[0][i] += term*c0;
+      out[1][i] += term*c1;
+      out[2][i] += term*c2;
+      out[3][i] += term*c3;
+    }
+  }
+  for(Int_t i=0;i<n;i++) {
+    for(Int_t k=0;k<kNOut;k++) sum[i*kNOut+k] = out[k][i];
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef ROOT_THcReconMatrix
+#define ROOT_THcReconMatrix
+
+//////////////////////////////////////////////////////////////////////////
+//
+// THcReconMatrix
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+/** \brief Evaluator of the COSY focal plane to target polynomials.
+ *
+ * Terms are kept in column arrays of coefficients and exponents of the
+ * 5 focal plane variables.  The powers of each variable are computed
+ * once per track in a table, and the four target quantities are summed in
+ * one pass over the terms.  EvalBatch does this for many tracks at once
+ * with the track index innermost.
+ */
+class THcReconMatrix {
+
+public:
+  enum { kNVar = 5, kNOut = 4, kMaxExp = 9 };
+
+  THcReconMatrix() { Clear(); }
+  virtual ~THcReconMatrix() {}
+
+  void   Clear();
+  void   AddTerm(const Double_t* coeff, const Int_t* exp);
+  Int_t  GetNTerms() const { return fNTerms; }
+
+  void   Eval(const Double_t* x, Double_t* sum) const;
+  void   EvalBatch(Int_t n, const Double_t* x, Double_t* sum);
+
+protected:
+  Int_t fNTerms;
+  Int_t fMaxExp[kNVar];		   // Highest power of each variable
+  std::vector<Double_t> fCoeff[kNOut];
+  std::vector<UChar_t>  fExp[kNVar];
+  std::vector<Double_t> fPow;	   // Power table of EvalBatch
+};
+
+#endif
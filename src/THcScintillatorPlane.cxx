@@ -35,17 +35,11 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
 					    const Int_t planenum,
 					    THaDetectorBase* parent )
 : THaSubDetector(name,description,parent),
-  fParentHitList(0), fCluster(0),frPosAdcErrorFlag(0), frNegAdcErrorFlag(0),
+  fParentHitList(0), fCluster(0),
   frPosTDCHits(0), frNegTDCHits(0), frPosADCHits(0), frNegADCHits(0),
   frPosADCSums(0), frNegADCSums(0), frPosADCPeds(0), frNegADCPeds(0),
-  fHodoHits(0), frPosTdcTimeRaw(0), frPosAdcPedRaw(0),
-  frPosAdcPulseIntRaw(0), frPosAdcPulseAmpRaw(0),
-  frPosAdcPulseTimeRaw(0), frPosTdcTime(0), frPosAdcPed(0),
-  frPosAdcPulseInt(0), frPosAdcPulseAmp(0), frPosAdcPulseTime(0),
-  frNegTdcTimeRaw(0), frNegAdcPedRaw(0), frNegAdcPulseIntRaw(0),
-  frNegAdcPulseAmpRaw(0), frNegAdcPulseTimeRaw(0), frNegTdcTime(0),
-  frNegAdcPed(0), frNegAdcPulseInt(0), frNegAdcPulseAmp(0),
-  frNegAdcPulseTime(0), fPosCenter(0), fHodoPosMinPh(0),
+  fHodoHits(0), frPosTdcTimeRaw(0), frPosTdcTime(0),
+  frNegTdcTimeRaw(0), frNegTdcTime(0), fPosCenter(0), fHodoPosMinPh(0),
   fHodoNegMinPh(0), fHodoPosPhcCoeff(0), fHodoNegPhcCoeff(0),
   fHodoPosTimeOffset(0), fHodoNegTimeOffset(0), fHodoVelLight(0),
   fHodoPosInvAdcOffset(0), fHodoNegInvAdcOffset(0),
@@ -64,9 +58,6 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
 
   fCluster = new TClonesArray("THcScintPlaneCluster", 10);
 
-  frPosAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-  frNegAdcErrorFlag = new TClonesArray("THcSignalHit", 16);
-
   frPosTDCHits = new TClonesArray("THcSignalHit",16);
   frNegTDCHits = new TClonesArray("THcSignalHit",16);
   frPosADCHits = new TClonesArray("THcSignalHit",16);
@@ -76,29 +67,11 @@ THcScintillatorPlane::THcScintillatorPlane( const char* name,
   frPosADCPeds = new TClonesArray("THcSignalHit",16);
   frNegADCPeds = new TClonesArray("THcSignalHit",16);
 
-  frPosTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frPosTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frPosAdcPulseTime = new TClonesArray("THcSignalHit", 16);
+  frPosTdcTimeRaw = new TClonesArray("THcSignalHit", 16);
+  frPosTdcTime    = new TClonesArray("THcSignalHit", 16);
 
-  frNegTdcTimeRaw      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frNegTdcTime      = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frNegAdcPulseTime = new TClonesArray("THcSignalHit", 16);
+  frNegTdcTimeRaw = new TClonesArray("THcSignalHit", 16);
+  frNegTdcTime    = new TClonesArray("THcSignalHit", 16);
 
 
   fPlaneNum = planenum;
@@ -112,8 +85,6 @@ THcScintillatorPlane::~THcScintillatorPlane()
   // Destructor
   if( fIsSetup )
     RemoveVariables();
-  delete  frPosAdcErrorFlag; frPosAdcErrorFlag = NULL;
-  delete  frNegAdcErrorFlag; frNegAdcErrorFlag = NULL;
 
   delete  fCluster; fCluster = NULL;
 
@@ -128,28 +99,12 @@ THcScintillatorPlane::~THcScintillatorPlane()
   delete frNegADCPeds;
 
   delete frPosTdcTimeRaw;
-  delete frPosAdcPedRaw;
-  delete frPosAdcPulseIntRaw;
-  delete frPosAdcPulseAmpRaw;
-  delete frPosAdcPulseTimeRaw;
 
   delete frPosTdcTime;
-  delete frPosAdcPed;
-  delete frPosAdcPulseInt;
-  delete frPosAdcPulseAmp;
-  delete frPosAdcPulseTime;
 
   delete frNegTdcTimeRaw;
-  delete frNegAdcPedRaw;
-  delete frNegAdcPulseIntRaw;
-  delete frNegAdcPulseAmpRaw;
-  delete frNegAdcPulseTimeRaw;
 
   delete frNegTdcTime;
-  delete frNegAdcPed;
-  delete frNegAdcPulseInt;
-  delete frNegAdcPulseAmp;
-  delete frNegAdcPulseTime;
 
   delete [] fPosCenter; fPosCenter = 0;
 
@@ -396,6 +351,9 @@ Int_t THcScintillatorPlane::ReadDatabase( const TDatime& date )
   fNumGoodPosTdcHits     = vector<Int_t> (fNelem, 0.0);
   fNumGoodNegTdcHits     = vector<Int_t> (fNelem, 0.0);
 
+  fPosAdcPulses.Reserve(fNelem*MaxNumAdcPulse);
+  fNegAdcPulses.Reserve(fNelem*MaxNumAdcPulse);
+
   fGoodPosAdcPed         = vector<Double_t> (fNelem, 0.0);
   fGoodNegAdcPed         = vector<Double_t> (fNelem, 0.0);
   fGoodPosAdcMult         = vector<Double_t> (fNelem, 0.0);
@@ -438,32 +396,13 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
 
   if (fDebugAdc) {
     RVarDef vars[] = {
-      {"posAdcErrorFlag", "Error Flag for When FPGA Fails", "frPosAdcErrorFlag.THcSignalHit.GetData()"},
-      {"negAdcErrorFlag", "Error Flag for When FPGA Fails", "frNegAdcErrorFlag.THcSignalHit.GetData()"},
-
       {"posTdcTimeRaw",      "List of positive raw TDC values.",           "frPosTdcTimeRaw.THcSignalHit.GetData()"},
-      {"posAdcPedRaw",       "List of positive raw ADC pedestals",         "frPosAdcPedRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseIntRaw",  "List of positive raw ADC pulse integrals.",  "frPosAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseAmpRaw",  "List of positive raw ADC pulse amplitudes.", "frPosAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"posAdcPulseTimeRaw", "List of positive raw ADC pulse times.",      "frPosAdcPulseTimeRaw.THcSignalHit.GetData()"},
 
       {"posTdcTime",         "List of positive TDC values.",               "frPosTdcTime.THcSignalHit.GetData()"},
-      {"posAdcPed",          "List of positive ADC pedestals",             "frPosAdcPed.THcSignalHit.GetData()"},
-      {"posAdcPulseInt",     "List of positive ADC pulse integrals.",      "frPosAdcPulseInt.THcSignalHit.GetData()"},
-      {"posAdcPulseAmp",     "List of positive ADC pulse amplitudes.",     "frPosAdcPulseAmp.THcSignalHit.GetData()"},
-      {"posAdcPulseTime",    "List of positive ADC pulse times.",          "frPosAdcPulseTime.THcSignalHit.GetData()"},
 
       {"negTdcTimeRaw",      "List of negative raw TDC values.",           "frNegTdcTimeRaw.THcSignalHit.GetData()"},
-      {"negAdcPedRaw",       "List of negative raw ADC pedestals",         "frNegAdcPedRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseIntRaw",  "List of negative raw ADC pulse integrals.",  "frNegAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseAmpRaw",  "List of negative raw ADC pulse amplitudes.", "frNegAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"negAdcPulseTimeRaw", "List of negative raw ADC pulse times.",      "frNegAdcPulseTimeRaw.THcSignalHit.GetData()"},
 
       {"negTdcTime",         "List of negative TDC values.",               "frNegTdcTime.THcSignalHit.GetData()"},
-      {"negAdcPed",          "List of negative ADC pedestals",             "frNegAdcPed.THcSignalHit.GetData()"},
-      {"negAdcPulseInt",     "List of negative ADC pulse integrals.",      "frNegAdcPulseInt.THcSignalHit.GetData()"},
-      {"negAdcPulseAmp",     "List of negative ADC pulse amplitudes.",     "frNegAdcPulseAmp.THcSignalHit.GetData()"},
-      {"negAdcPulseTime",    "List of negative ADC pulse times.",          "frNegAdcPulseTime.THcSignalHit.GetData()"},
 
       {"totNumPosAdcHits", "Total Number of Positive ADC Hits",   "fTotNumPosAdcHits"}, // Hodo+ raw ADC multiplicity Int_t
       {"totNumNegAdcHits", "Total Number of Negative ADC Hits",   "fTotNumNegAdcHits"}, // Hodo- raw ADC multiplicity  ""
@@ -475,16 +414,48 @@ Int_t THcScintillatorPlane::DefineVariables( EMode mode )
       { 0 }
     };
     DefineVarsFromList( vars, mode);
+
+    VarDef pulsevars[] = {
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "posAdcErrorFlag", "Error Flag for When FPGA Fails"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "negAdcErrorFlag", "Error Flag for When FPGA Fails"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "posAdcPedRaw", "List of positive raw ADC pedestals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "posAdcPulseIntRaw", "List of positive raw ADC pulse integrals."),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "posAdcPulseAmpRaw", "List of positive raw ADC pulse amplitudes."),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "posAdcPulseTimeRaw", "List of positive raw ADC pulse times."),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "posAdcPed", "List of positive ADC pedestals"),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "posAdcPulseInt", "List of positive ADC pulse integrals."),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "posAdcPulseAmp", "List of positive ADC pulse amplitudes."),
+      fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "posAdcPulseTime", "List of positive ADC pulse times."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "negAdcPedRaw", "List of negative raw ADC pedestals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "negAdcPulseIntRaw", "List of negative raw ADC pulse integrals."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "negAdcPulseAmpRaw", "List of negative raw ADC pulse amplitudes."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "negAdcPulseTimeRaw", "List of negative raw ADC pulse times."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "negAdcPed", "List of negative ADC pedestals"),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "negAdcPulseInt", "List of negative ADC pulse integrals."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "negAdcPulseAmp", "List of negative ADC pulse amplitudes."),
+      fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "negAdcPulseTime", "List of negative ADC pulse times."),
+      { 0 }
+    };
+    DefineVarsFromList( pulsevars, mode );
+    if( mode == kDefine )
+      THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
   } //end debug statement
 
+  VarDef pulsevars[] = {
+    fPosAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "posAdcCounter", "List of positive ADC counter numbers."),
+    fNegAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "negAdcCounter", "List of negative ADC counter numbers."),
+    { 0 }
+  };
+  DefineVarsFromList( pulsevars, mode );
+  if( mode == kDefine )
+    THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
+
   RVarDef vars[] = {
     {"betterTest", "List of positive TDC counter numbers.", "frPosTdcTimeRawBetter"},   //Hodo+ raw TDC occupancy
     {"nhits", "Number of paddle hits (passed TDC && ADC Min and Max cuts for either end)",           "GetNScinHits() "},
 
     {"posTdcCounter", "List of positive TDC counter numbers.", "frPosTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},   //Hodo+ raw TDC occupancy
-    {"posAdcCounter", "List of positive ADC counter numbers.", "frPosAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"}, //Hodo+ raw ADC occupancy
     {"negTdcCounter", "List of negative TDC counter numbers.", "frNegTdcTimeRaw.THcSignalHit.GetPaddleNumber()"},     //Hodo- raw TDC occupancy
-    {"negAdcCounter", "List of negative ADC counter numbers.", "frNegAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},  //Hodo- raw ADC occupancy
 
     {"fptime", "Time at focal plane",     "GetFpTime()"},
 
@@ -557,8 +528,8 @@ void THcScintillatorPlane::Clear( Option_t* )
   // Clears the hit lists
   fCluster->Clear();
 
-  frPosAdcErrorFlag->Clear();
-  frNegAdcErrorFlag->Clear();
+  fPosAdcPulses.Clear();
+  fNegAdcPulses.Clear();
 
   fHodoHits->Clear();
   frPosTDCHits->Clear();
@@ -567,28 +538,9 @@ void THcScintillatorPlane::Clear( Option_t* )
   frNegADCHits->Clear();
 
   frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
   frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
   frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
   frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
 
 
   //Clear occupancies
@@ -704,8 +656,6 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
   Int_t nrNegTDCHits=0;
   Int_t nrPosADCHits=0;
   Int_t nrNegADCHits=0;
-  UInt_t nrPosAdcHits = 0;
-  UInt_t nrNegAdcHits = 0;
   UInt_t nrPosTdcHits = 0;
   UInt_t nrNegTdcHits = 0;
   frPosTDCHits->Clear();
@@ -719,28 +669,12 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
 
   frPosTdcTimeRaw->Clear();
-  frPosAdcPedRaw->Clear();
-  frPosAdcPulseIntRaw->Clear();
-  frPosAdcPulseAmpRaw->Clear();
-  frPosAdcPulseTimeRaw->Clear();
-
   frPosTdcTime->Clear();
-  frPosAdcPed->Clear();
-  frPosAdcPulseInt->Clear();
-  frPosAdcPulseAmp->Clear();
-  frPosAdcPulseTime->Clear();
-
   frNegTdcTimeRaw->Clear();
-  frNegAdcPedRaw->Clear();
-  frNegAdcPulseIntRaw->Clear();
-  frNegAdcPulseAmpRaw->Clear();
-  frNegAdcPulseTimeRaw->Clear();
-
   frNegTdcTime->Clear();
-  frNegAdcPed->Clear();
-  frNegAdcPulseInt->Clear();
-  frNegAdcPulseAmp->Clear();
-  frNegAdcPulseTime->Clear();
+
+  fPosAdcPulses.Clear();
+  fNegAdcPulses.Clear();
   //stripped
   fNScinHits=0;
 
@@ -803,43 +737,15 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
     }
     THcRawAdcHit& rawPosAdcHit = hit->GetRawAdcHitPos();
     for (UInt_t thit=0; thit<rawPosAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frPosAdcPedRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPedRaw());
-      ((THcSignalHit*) frPosAdcPed->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPed());
-
-      ((THcSignalHit*) frPosAdcPulseIntRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseInt->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmpRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmpRaw(thit));
-
-      ((THcSignalHit*) frPosAdcPulseAmp->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frPosAdcPulseTimeRaw->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frPosAdcPulseTime->ConstructedAt(nrPosAdcHits))->Set(padnum, rawPosAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 0);
-      if (rawPosAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frPosAdcErrorFlag->ConstructedAt(nrPosAdcHits))->Set(padnum, 1);
-
-      ++nrPosAdcHits;
+      fPosAdcPulses.AddPulse(padnum, rawPosAdcHit, thit, fAdcTdcOffset,
+			     rawPosAdcHit.GetPulseAmpRaw(thit) <= 0);
       fTotNumAdcHits++;
       fTotNumPosAdcHits++;
     }
     THcRawAdcHit& rawNegAdcHit = hit->GetRawAdcHitNeg();
     for (UInt_t thit=0; thit<rawNegAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frNegAdcPedRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPedRaw());
-      ((THcSignalHit*) frNegAdcPed->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPed());
-
-      ((THcSignalHit*) frNegAdcPulseIntRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseInt->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frNegAdcPulseAmpRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseAmp->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseAmp(thit));
-      ((THcSignalHit*) frNegAdcPulseTimeRaw->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frNegAdcPulseTime->ConstructedAt(nrNegAdcHits))->Set(padnum, rawNegAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) > 0)  ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 0);
-      if (rawNegAdcHit.GetPulseAmpRaw(thit) <= 0) ((THcSignalHit*) frNegAdcErrorFlag->ConstructedAt(nrNegAdcHits))->Set(padnum, 1);
-
-      ++nrNegAdcHits;
+      fNegAdcPulses.AddPulse(padnum, rawNegAdcHit, thit, fAdcTdcOffset,
+			     rawNegAdcHit.GetPulseAmpRaw(thit) <= 0);
       fTotNumAdcHits++;
       fTotNumNegAdcHits++;
     }
@@ -850,7 +756,7 @@ Int_t THcScintillatorPlane::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
     if (hit->GetRawTdcHitNeg().GetNHits() > 0)
       ((THcSignalHit*) frNegTDCHits->ConstructedAt(nrNegTDCHits++))->Set(padnum, hit->GetRawTdcHitNeg().GetTime()+fTdcOffset);
     // Should we make lists of offset corrected ADC Pulse times here too?  For now
-    // the frNegAdcPulseTime frPosAdcPulseTime have that offset correction.
+    // the fNegAdcPulses and fPosAdcPulses times have that offset correction.
     //
     Bool_t badcraw_pos=kFALSE;
     Bool_t badcraw_neg=kFALSE;
@@ -15,6 +15,7 @@
 #include "THaSubDetector.h"
 #include "TClonesArray.h"
 #include "THcScintPlaneCluster.h"
+#include "THcAdcPulseTable.h"
 
 using namespace std;
 
@@ -79,8 +80,9 @@ class THcScintillatorPlane : public THaSubDetector {
 
  protected:
 
-  TClonesArray* frPosAdcErrorFlag;
-  TClonesArray* frNegAdcErrorFlag;
+  static const Int_t MaxNumAdcPulse = 4;
+  THcAdcPulseTable fPosAdcPulses;	// All positive FADC pulses of the event
+  THcAdcPulseTable fNegAdcPulses;	// All negative FADC pulses of the event
 
 
   TClonesArray* frPosTDCHits;
@@ -96,28 +98,9 @@ class THcScintillatorPlane : public THaSubDetector {
   std::vector<double> frPosTdcTimeRawBetter;
 
   TClonesArray* frPosTdcTimeRaw;
-  TClonesArray* frPosAdcPedRaw;
-  TClonesArray* frPosAdcPulseIntRaw;
-  TClonesArray* frPosAdcPulseAmpRaw;
-  TClonesArray* frPosAdcPulseTimeRaw;
-
   TClonesArray* frPosTdcTime;
-  TClonesArray* frPosAdcPed;
-  TClonesArray* frPosAdcPulseInt;
-  TClonesArray* frPosAdcPulseAmp;
-  TClonesArray* frPosAdcPulseTime;
-
   TClonesArray* frNegTdcTimeRaw;
-  TClonesArray* frNegAdcPedRaw;
-  TClonesArray* frNegAdcPulseIntRaw;
-  TClonesArray* frNegAdcPulseAmpRaw;
-  TClonesArray* frNegAdcPulseTimeRaw;
-
   TClonesArray* frNegTdcTime;
-  TClonesArray* frNegAdcPed;
-  TClonesArray* frNegAdcPulseInt;
-  TClonesArray* frNegAdcPulseAmp;
-  TClonesArray* frNegAdcPulseTime;
 
   //Hodoscopes Multiplicities
   Int_t fTotNumPosAdcHits;
@@ -360,6 +360,11 @@ Int_t THcShower::ReadDatabase( const TDatime& date )
   fNTotBlocks=0;              //total number of blocks in the layers
   for (UInt_t i=0; i<fNLayers; i++) fNTotBlocks += fNBlocks[i];
 
+  // Clustering grid: blocks of a layer are rows, layers are columns.
+  UInt_t maxblocks=0;
+  for (UInt_t i=0; i<fNLayers; i++) maxblocks = TMath::Max(maxblocks, fNBlocks[i]);
+  fClusterer.Init(maxblocks, fNLayers);
+
   // Debug output.
   if (fdbg_init_cal)
     cout << "  Total number of blocks in the layers of calorimeter: " << dec
@@ -750,7 +755,7 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
   THcHallCSpectrometer *app = static_cast<THcHallCSpectrometer*>(GetApparatus());
   fEtotNorm=fEtot/(app->GetPcentral());
   //
-  THcShowerHitSet HitSet;
+  vector<THcShowerHit*> HitList;
 
   for(UInt_t j=0; j < fNLayers; j++) {
 
@@ -775,13 +780,13 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 
 	THcShowerHit* hit = new THcShowerHit(i,j,x,y,z,Edep,Epos,Eneg);
 
-	HitSet.insert(hit);   //<set> version
+	HitList.push_back(hit);
       }
 
     }
   }
 
-  fNhits = HitSet.size();
+  fNhits = HitList.size();
 
   //Debug output, print out hits before clustering.
 
@@ -792,17 +797,15 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 
     cout << " event = " << fEvent << endl;
     cout << "  List of unclustered hits. Total hits:     " << fNhits << endl;
-    THcShowerHitIt it = HitSet.begin();    //<set> version
     for (Int_t i=0; i!=fNhits; i++) {
       cout << "  hit " << i << ": ";
-      (*(it++))->show();
+      HitList[i]->show();
     }
   }
 
   // Fill list of clusters.
 
-  ClusterHits(HitSet, fClusterList);
-  assert( HitSet.empty() );  // else bug in ClusterHits()
+  fClusterer.Cluster(HitList, fClusterList);
 
   fNclust = (*fClusterList).size();   //number of clusters
 
@@ -858,54 +861,6 @@ Int_t THcShower::CoarseProcess( TClonesArray& tracks)
 
 //-----------------------------------------------------------------------------
 
-void THcShower::ClusterHits(THcShowerHitSet& HitSet,
-			    THcShowerClusterList* ClusterList) {
-
-  // Collect hits from the HitSet into the clusters. The resultant clusters
-  // of hits are saved in the ClusterList.
-
-  while (HitSet.size() != 0) {
-
-    THcShowerCluster* cluster = new THcShowerCluster;
-
-    THcShowerHitIt it = HitSet.end();
-    (*cluster).insert(*(--it));   //Move the last hit from the hit list
-    HitSet.erase(it);             //into the 1st cluster
-
-    bool clustered = true;
-
-    while (clustered) {                   //Proceed while a hit is clustered
-
-      clustered = false;
-
-      for (THcShowerHitIt i=HitSet.begin(); i!=HitSet.end(); ++i) {
-
-	for (THcShowerClusterIt k=(*cluster).begin(); k!=(*cluster).end();
-	     ++k) {
-
-	  if ((**i).isNeighbour(*k)) {
-	    (*cluster).insert(*i);      //If the hit #i is neighbouring a hit
-	    HitSet.erase(i);            //in the cluster, then move it
-	                                //into the cluster.
-	    clustered = true;
-	  }
-
-	  if (clustered) break;
-	}                               //k
-
-	if (clustered) break;
-      }                                 //i
-
-    }                                   //while clustered
-
-    ClusterList->push_back(cluster);   //Put the cluster in the cluster list
-
-  }                                     //While hit_list not exhausted
-
-};
-
-//-----------------------------------------------------------------------------
-
 // Various helper functions to accumulate hit related quantities.
 
 Double_t addE(Double_t x, THcShowerHit* h) {
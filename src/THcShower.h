@@ -13,6 +13,7 @@
 #include "THcShowerPlane.h"
 #include "THcShowerArray.h"
 #include "THcShowerHit.h"
+#include "THcShowerClusterer.h"
 #include "TMath.h"
 
 #include "hcana/Logger.h"
@@ -228,6 +229,7 @@ protected:
   Double_t fETotTrackNorm;   // Total energy divided by momentum of the best track
 
   THcShowerClusterList* fClusterList;   // List of hit clusters
+  THcShowerClusterer fClusterer;        //! Block neighbour table of the layers
 
 
   // Geometrical parameters.
@@ -280,7 +282,6 @@ protected:
   // Cluster to track association method.
   Int_t MatchCluster(THaTrack*, Double_t&, Double_t&);
 
-  void ClusterHits(THcShowerHitSet& HitSet, THcShowerClusterList* ClusterList);
 
   virtual Int_t      End(THaRunBase *r = 0);
 
@@ -43,17 +43,6 @@ THcShowerArray::THcShowerArray( const char* name,
   fADCHits = new TClonesArray("THcSignalHit",100);
   fLayerNum = layernum;
 
-  frAdcPedRaw       = new TClonesArray("THcSignalHit", 16);
-  frAdcErrorFlag    = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseIntRaw  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseAmpRaw  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseTimeRaw = new TClonesArray("THcSignalHit", 16);
-
-  frAdcPed       = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseInt  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseAmp  = new TClonesArray("THcSignalHit", 16);
-  frAdcPulseTime = new TClonesArray("THcSignalHit", 16);
-
   fClusterList = new THcShowerClusterList;         // List of hit clusters
 }
 
@@ -83,17 +72,6 @@ THcShowerArray::~THcShowerArray()
 
   delete fADCHits; fADCHits = NULL;
 
-  delete frAdcPedRaw; frAdcPedRaw = NULL;
-  delete frAdcErrorFlag; frAdcErrorFlag = NULL;
-  delete frAdcPulseIntRaw; frAdcPulseIntRaw = NULL;
-  delete frAdcPulseAmpRaw; frAdcPulseAmpRaw = NULL;
-  delete frAdcPulseTimeRaw; frAdcPulseTimeRaw = NULL;
-
-  delete frAdcPed; frAdcPed = NULL;
-  delete frAdcPulseInt; frAdcPulseInt = NULL;
-  delete frAdcPulseAmp; frAdcPulseAmp = NULL;
-  delete frAdcPulseTime; frAdcPulseTime = NULL;
-
   //  delete [] fA;
   //delete [] fP;
   // delete [] fA_p;
@@ -184,6 +162,8 @@ Int_t THcShowerArray::ReadDatabase( const TDatime& date )
 
   gHcParms->LoadParmValues((DBRequest*)&list, prefix);
   fNelem = fNRows*fNColumns;
+  fClusterer.Init(fNRows, fNColumns);
+  fAdcPulses.Reserve(fNelem);
 
   fXPos = new Double_t* [fNRows];
   fYPos = new Double_t* [fNRows];
@@ -424,27 +404,33 @@ Int_t THcShowerArray::DefineVariables( EMode mode )
 
   // Register variables in global list
   if (fDebugAdc) {
-    RVarDef vars[] = {
-      {"adcPedRaw",       "List of raw ADC pedestals",         "frAdcPedRaw.THcSignalHit.GetData()"},
-      {"adcPulseIntRaw",  "List of raw ADC pulse integrals.",  "frAdcPulseIntRaw.THcSignalHit.GetData()"},
-      {"adcPulseAmpRaw",  "List of raw ADC pulse amplitudes.", "frAdcPulseAmpRaw.THcSignalHit.GetData()"},
-      {"adcPulseTimeRaw", "List of raw ADC pulse times.",      "frAdcPulseTimeRaw.THcSignalHit.GetData()"},
-
-      {"adcPed",          "List of ADC pedestals",             "frAdcPed.THcSignalHit.GetData()"},
-      {"adcPulseInt",     "List of ADC pulse integrals.",      "frAdcPulseInt.THcSignalHit.GetData()"},
-      {"adcPulseAmp",     "List of ADC pulse amplitudes.",     "frAdcPulseAmp.THcSignalHit.GetData()"},
-      {"adcPulseTime",    "List of ADC pulse times.",          "frAdcPulseTime.THcSignalHit.GetData()"},
+    VarDef pulsevars[] = {
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPedRaw, "adcPedRaw", "List of raw ADC pedestals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseIntRaw, "adcPulseIntRaw", "List of raw ADC pulse integrals."),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmpRaw, "adcPulseAmpRaw", "List of raw ADC pulse amplitudes."),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTimeRaw, "adcPulseTimeRaw", "List of raw ADC pulse times."),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPed, "adcPed", "List of ADC pedestals"),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseInt, "adcPulseInt", "List of ADC pulse integrals."),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseAmp, "adcPulseAmp", "List of ADC pulse amplitudes."),
+      fAdcPulses.MakeVarDef(THcAdcPulseTable::kPulseTime, "adcPulseTime", "List of ADC pulse times."),
       { 0 }
     };
-    DefineVarsFromList( vars, mode);
+    DefineVarsFromList( pulsevars, mode );
+    if( mode == kDefine )
+      THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
   } //end debug statement
 
+  VarDef pulsevars[] = {
+    fAdcPulses.MakeVarDef(THcAdcPulseTable::kErrorFlag, "adcErrorFlag", "Error Flag When FPGA Fails"),
+    fAdcPulses.MakeVarDef(THcAdcPulseTable::kPaddle, "adcCounter", "List of ADC counter numbers."),
+    { 0 }
+  };
+  DefineVarsFromList( pulsevars, mode );
+  if( mode == kDefine )
+    THcAdcPulseTable::CheckVariables( pulsevars, GetPrefix() );
+
   RVarDef vars[] = {
     //{"adchits", "List of ADC hits", "fADCHits.THcSignalHit.GetPaddleNumber()"}, // appears an empty histogram in the root file
-
-    {"adcErrorFlag",       "Error Flag When FPGA Fails",      "frAdcErrorFlag.THcSignalHit.GetData()"},
-
-    {"adcCounter",      "List of ADC counter numbers.",      "frAdcPulseIntRaw.THcSignalHit.GetPaddleNumber()"},  //raw occupancy
     {"numGoodAdcHits", "Number of Good ADC Hits per PMT", "fNumGoodAdcHits" },                                   //good occupancy
 
     {"totNumAdcHits", "Total Number of ADC Hits", "fTotNumAdcHits" },                                            // raw multiplicity
@@ -494,16 +480,7 @@ void THcShowerArray::Clear( Option_t* )
   }
   fClusterList->clear();
 
-  frAdcPedRaw->Clear();
-  frAdcErrorFlag->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
+  fAdcPulses.Clear();
 
   for (UInt_t ielem = 0; ielem < fGoodAdcPed.size(); ielem++) {
     fGoodAdcPulseIntRaw.at(ielem)      = 0.0;
@@ -536,7 +513,7 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
   // Save energy deposition in the module as hit mean energy, do not use
   // positive and negative side energies.
 
-  THcShowerHitSet HitSet;         //set of hits
+  vector<THcShowerHit*> HitList;  //hits in block order
 
   UInt_t k=0;
   for(UInt_t j=0; j < fNColumns; j++) {
@@ -547,7 +524,7 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
 	THcShowerHit* hit =
 	  new THcShowerHit(i, j, fXPos[i][j], fYPos[i][j], fZPos[i][j], fE[k], 0., 0.);
 
-	HitSet.insert(hit);
+	HitList.push_back(hit);
       }
 
       k++;
@@ -561,26 +538,24 @@ Int_t THcShowerArray::CoarseProcess( TClonesArray& tracks )
 	 << endl;
 
     cout << "  List of unclustered hits. Total hits:     " << fTotNumAdcHits << endl;
-    THcShowerHitIt it = HitSet.begin();    //<set> version
-    for (Int_t i=0; i!=fTotNumGoodAdcHits; i++) {
+    for (UInt_t i=0; i!=HitList.size(); i++) {
       cout << "  hit " << i << ": ";
-      (*(it++))->show();
+      HitList[i]->show();
     }
   }
 
   ////Sanity check. (Vardan)
 
-  // if ((int)HitSet.size() != fTotNumGoodAdcHits) {
+  // if ((int)HitList.size() != fTotNumGoodAdcHits) {
   //	cout << "***" << endl;
-  //	cout << "*** THcShowerArray::CoarseProcess: HitSet.size = " << HitSet.size()
+  //	cout << "*** THcShowerArray::CoarseProcess: HitList.size = " << HitList.size()
   //	     << " != fTotNumGoodAdcHits = " << fTotNumGoodAdcHits << endl;
   //	cout << "***" << endl;
   //    }
 
   // Cluster hits and fill list of clusters.
 
-  static_cast<THcShower*>(fParent)->ClusterHits(HitSet, fClusterList);
-  assert( HitSet.empty() );  // else bug in ClusterHits()
+  fClusterer.Cluster(HitList, fClusterList);
 
   fNclust = (*fClusterList).size();         //number of clusters
 
@@ -873,16 +848,16 @@ void THcShowerArray::FillADC_DynamicPedestal()
 {
   Double_t StartTime = 0.0;
   if( fglHod ) StartTime = fglHod->GetStartTime();
-  for (Int_t ielem=0;ielem<frAdcPulseInt->GetEntries();ielem++) {
+  for (Int_t ielem=0;ielem<(Int_t)fAdcPulses.GetSize();ielem++) {
     
-    Int_t npad           = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetPaddleNumber() - 1;
-    Double_t pulseIntRaw = ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(ielem))->GetData();
-    Double_t pulsePed    = ((THcSignalHit*) frAdcPed->ConstructedAt(ielem))->GetData();
-    Double_t pulseInt    = ((THcSignalHit*) frAdcPulseInt->ConstructedAt(ielem))->GetData();
-    Double_t pulseAmp    = ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(ielem))->GetData();
-    Double_t pulseTime   = ((THcSignalHit*) frAdcPulseTime->ConstructedAt(ielem))->GetData();
+    Int_t npad           = fAdcPulses.GetPaddle(ielem) - 1;
+    Double_t pulseIntRaw = fAdcPulses.GetPulseIntRaw(ielem);
+    Double_t pulsePed    = fAdcPulses.GetPed(ielem);
+    Double_t pulseInt    = fAdcPulses.GetPulseInt(ielem);
+    Double_t pulseAmp    = fAdcPulses.GetPulseAmp(ielem);
+    Double_t pulseTime   = fAdcPulses.GetPulseTime(ielem);
     Double_t adctdcdiffTime = StartTime-pulseTime;
-    Bool_t errorflag     = ((THcSignalHit*) frAdcErrorFlag->ConstructedAt(ielem))->GetData();
+    Bool_t errorflag     = fAdcPulses.GetErrorFlag(ielem);
     Bool_t pulseTimeCut  = (adctdcdiffTime > fAdcTimeWindowMin[npad]) &&  (adctdcdiffTime < fAdcTimeWindowMax[npad]);
 
     if (!errorflag)
@@ -923,16 +898,7 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
   fADCHits->Clear();
 
-  frAdcPedRaw->Clear();
-  frAdcErrorFlag->Clear();
-  frAdcPulseIntRaw->Clear();
-  frAdcPulseAmpRaw->Clear();
-  frAdcPulseTimeRaw->Clear();
-
-  frAdcPed->Clear();
-  frAdcPulseInt->Clear();
-  frAdcPulseAmp->Clear();
-  frAdcPulseTime->Clear();
+  fAdcPulses.Clear();
 
   for(Int_t i=0;i<fNelem;i++) {
     //fA[i] = 0;
@@ -951,8 +917,6 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
 
   Int_t ihit = nexthit;
 
-  UInt_t nrAdcHits = 0;
-
   while(ihit < nrawhits) {
     THcRawShowerHit* hit = (THcRawShowerHit *) rawhits->At(ihit);
 
@@ -964,25 +928,9 @@ Int_t THcShowerArray::ProcessHits(TClonesArray* rawhits, Int_t nexthit)
     THcRawAdcHit& rawAdcHit = hit->GetRawAdcHitPos();
     //
     for (UInt_t thit=0; thit<rawAdcHit.GetNPulses(); ++thit) {
-      ((THcSignalHit*) frAdcPedRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPedRaw());
-        fThresh[padnum-1]=rawAdcHit.GetPedRaw()*rawAdcHit.GetF250_PeakPedestalRatio()+fAdcThreshold;
-     ((THcSignalHit*) frAdcPed->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPed());
-
-      ((THcSignalHit*) frAdcPulseIntRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseIntRaw(thit));
-      ((THcSignalHit*) frAdcPulseInt->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseInt(thit));
-
-      ((THcSignalHit*) frAdcPulseAmpRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseAmpRaw(thit));
-      ((THcSignalHit*) frAdcPulseAmp->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseAmp(thit));
-
-      ((THcSignalHit*) frAdcPulseTimeRaw->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseTimeRaw(thit));
-      ((THcSignalHit*) frAdcPulseTime->ConstructedAt(nrAdcHits))->Set(padnum, rawAdcHit.GetPulseTime(thit)+fAdcTdcOffset);
-
-      if (rawAdcHit.GetPulseAmp(thit)>0&&rawAdcHit.GetPulseIntRaw(thit)>0) {
-	((THcSignalHit*) frAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(padnum,0);
-      } else {
-	((THcSignalHit*) frAdcErrorFlag->ConstructedAt(nrAdcHits))->Set(padnum,1);
-      }
-      ++nrAdcHits;
+      fThresh[padnum-1]=rawAdcHit.GetPedRaw()*rawAdcHit.GetF250_PeakPedestalRatio()+fAdcThreshold;
+      fAdcPulses.AddPulse(padnum, rawAdcHit, thit, fAdcTdcOffset,
+			  !(rawAdcHit.GetPulseAmp(thit)>0&&rawAdcHit.GetPulseIntRaw(thit)>0));
     }
     ihit++;
   }
@@ -20,6 +20,8 @@
 #include "THaTrack.h"
 #include "TClonesArray.h"
 #include "THcShowerHit.h"
+#include "THcShowerClusterer.h"
+#include "THcAdcPulseTable.h"
 
 #include <iostream>
 
@@ -189,17 +191,9 @@ protected:
   Double_t fClustSize;
 
   THcShowerClusterList* fClusterList;   // List of hit clusters
+  THcShowerClusterer fClusterer;        //! Block neighbour table of the array
 
-  TClonesArray* frAdcPedRaw;
-  TClonesArray* frAdcErrorFlag;
-  TClonesArray* frAdcPulseIntRaw;
-  TClonesArray* frAdcPulseAmpRaw;
-  TClonesArray* frAdcPulseTimeRaw;
-
-  TClonesArray* frAdcPed;
-  TClonesArray* frAdcPulseInt;
-  TClonesArray* frAdcPulseAmp;
-  TClonesArray* frAdcPulseTime;
+  THcAdcPulseTable fAdcPulses;          // All FADC pulses of the event
 
   //Quatitites for efficiency calculations.
 
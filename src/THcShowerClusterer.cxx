@@ -0,0 +1,111 @@
+/** \class THcShowerClusterer
+    \ingroup DetSupport
+
+\brief Neighbour table clustering of shower hits
+
+Used by THcShower::CoarseProcess for the layered calorimeter (rows are the
+blocks of a layer, columns the layers) and by THcShowerArray::CoarseProcess
+for the fly's eye array.  Block b of the grid is column*nrows+row.
+
+The clusters are the same as those of the former THcShower::ClusterHits,
+which grew each cluster by rescanning all remaining hits against all hits
+already in the cluster.  Clusters are seeded from the last remaining hit in
+fill order, so they come out in the order that code gave for hits allocated
+at increasing addresses.
+
+*/
+#include "THcShowerClusterer.h"
+
+using namespace std;
+
+//_____________________________________________________________________________
+THcShowerClusterer::THcShowerClusterer() :
+  fNRows(0), fNColumns(0), fNBlocks(0)
+{
+}
+
+//_____________________________________________________________________________
+void THcShowerClusterer::Init(UInt_t nrows, UInt_t ncolumns)
+{
+  // Tabulate the neighbours of each block.  Two blocks are neighbours if
+  // they share a side or a corner, or are in the same row with at most
+  // one block between them.
+  fNRows = nrows;
+  fNColumns = ncolumns;
+  fNBlocks = nrows*ncolumns;
+
+  fNbrFirst.assign(fNBlocks+1, 0);
+  fNbr.clear();
+  for(UInt_t col=0; col<fNColumns; col++) {
+    for(UInt_t row=0; row<fNRows; row++) {
+      for(Int_t dcol=-2; dcol<=2; dcol++) {
+	for(Int_t drow=-1; drow<=1; drow++) {
+	  if(dcol==0 && drow==0) continue;
+	  if(TMath::Abs(dcol)==2 && drow!=0) continue;
+	  Int_t ncol = col+dcol;
+	  Int_t nrow = row+drow;
+	  if(ncol<0 || ncol>=(Int_t)fNColumns || nrow<0 || nrow>=(Int_t)fNRows)
+	    continue;
+	  fNbr.push_back(ncol*fNRows+nrow);
+	}
+      }
+      fNbrFirst[col*fNRows+row+1] = fNbr.size();
+    }
+  }
+  fHitOfBlock.assign(fNBlocks, -1);
+}
+
+//_____________________________________________________________________________
+UInt_t THcShowerClusterer::Cluster(const vector<THcShowerHit*>& hits,
+				   THcShowerClusterList* ClusterList)
+{
+  // Group the hits into clusters and append them to ClusterList.
+  // Return the number of clusters added.  A hit outside the grid, or a
+  // second hit in a block, makes a cluster of its own.
+  UInt_t nhits = hits.size();
+  fBlock.resize(nhits);
+  fLabel.assign(nhits, -1);
+
+  for(UInt_t ihit=0; ihit<nhits; ihit++) {
+    Int_t row = hits[ihit]->hitRow();
+    Int_t col = hits[ihit]->hitColumn();
+    fBlock[ihit] = -1;
+    if(row<0 || row>=(Int_t)fNRows || col<0 || col>=(Int_t)fNColumns) continue;
+    Int_t block = col*fNRows+row;
+    if(fHitOfBlock[block] >= 0) continue;
+    fHitOfBlock[block] = ihit;
+    fBlock[ihit] = block;
+  }
+
+  Int_t nclust = 0;
+  for(Int_t iseed=nhits-1; iseed>=0; iseed--) {
+    if(fLabel[iseed] >= 0) continue;
+    fLabel[iseed] = nclust;
+    if(fBlock[iseed] >= 0) {
+      fQueue.clear();
+      fQueue.push_back(fBlock[iseed]);
+      for(UInt_t iq=0; iq<fQueue.size(); iq++) {
+	UInt_t block = fQueue[iq];
+	for(UInt_t in=fNbrFirst[block]; in<fNbrFirst[block+1]; in++) {
+	  Int_t ihit = fHitOfBlock[fNbr[in]];
+	  if(ihit >= 0 && fLabel[ihit] < 0) {
+	    fLabel[ihit] = nclust;
+	    fQueue.push_back(fNbr[in]);
+	  }
+	}
+      }
+    }
+    nclust++;
+  }
+
+  UInt_t first = ClusterList->size();
+  for(Int_t i=0; i<nclust; i++) {
+    ClusterList->push_back(new THcShowerCluster);
+  }
+  for(UInt_t ihit=0; ihit<nhits; ihit++) {
+    (*ClusterList)[first+fLabel[ihit]]->insert(hits[ihit]);
+    if(fBlock[ihit] >= 0) fHitOfBlock[fBlock[ihit]] = -1;
+  }
+
+  return nclust;
+}
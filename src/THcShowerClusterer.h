@@ -0,0 +1,47 @@
+#ifndef ROOT_THcShowerClusterer
+#define ROOT_THcShowerClusterer
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THcShowerClusterer                                                        //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "THcShowerHit.h"
+
+/** \brief Clustering of calorimeter hits on a grid of blocks.
+ *
+ * The neighbours of each block, as defined by THcShowerHit::isNeighbour,
+ * are tabulated once from the grid size.  Clusters are the connected
+ * sets of fired blocks, found with a breadth first search over flat
+ * arrays that keep their capacity between events.
+ */
+class THcShowerClusterer {
+
+public:
+  THcShowerClusterer();
+
+  void   Init(UInt_t nrows, UInt_t ncolumns);
+  UInt_t Cluster(const std::vector<THcShowerHit*>& hits, THcShowerClusterList* ClusterList);
+
+  UInt_t GetNNeighbours(UInt_t block) const
+    { return block < fNBlocks ? fNbrFirst[block+1]-fNbrFirst[block] : 0; }
+
+protected:
+  UInt_t fNRows;
+  UInt_t fNColumns;
+  UInt_t fNBlocks;
+
+  // Neighbours of block b are fNbr[fNbrFirst[b]] .. fNbr[fNbrFirst[b+1]-1]
+  std::vector<UInt_t> fNbrFirst;
+  std::vector<UInt_t> fNbr;
+
+  // Per event scratch
+  std::vector<Int_t>  fHitOfBlock;	// Hit in each block, -1 if none
+  std::vector<Int_t>  fBlock;		// Block of each hit, -1 if off the grid
+  std::vector<Int_t>  fLabel;		// Cluster of each hit
+  std::vector<UInt_t> fQueue;
+};
+
+#endif
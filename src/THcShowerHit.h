@@ -4,6 +4,7 @@
 // HMS calorimeter hits, version 2
 
 #include <set>
+#include <vector>
 #include <iterator>
 #include <iostream>
 #include <memory>
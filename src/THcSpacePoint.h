@@ -15,7 +15,7 @@ class THcSpacePoint : public TObject {
 public:
 
   THcSpacePoint(Int_t nhits=0, Int_t ncombos=0) :
-  fNHits(nhits), fNCombos(ncombos),fSetStubFlag(kFALSE) {
+  fNHits(nhits), fNCombos(ncombos),fSetStubFlag(kFALSE),fNTracks(0) {
     fHits.clear();
   }
   virtual ~THcSpacePoint() {}
@@ -29,7 +29,7 @@ public:
   };
 
   void SetXY(Double_t x, Double_t y) {fX = x; fY = y;};
-  void Clear(Option_t* opt="") {fNHits=0; fNCombos=0; fHits.clear();};
+  void Clear(Option_t* opt="") {fNHits=0; fNCombos=0; fHits.clear(); fSetStubFlag=kFALSE; fNTracks=0;};
   void AddHit(THcDCHit* hit) {
     Hit newhit;
     newhit.dchit = hit;
@@ -69,6 +69,10 @@ public:
   void IncCombos() { fNCombos++; };
   void SetCombos(Int_t ncombos) { fNCombos=ncombos; };
   Int_t GetCombos() { return fNCombos; };
+  // Number of focal plane tracks using this space point, set by LinkStubs
+  void IncNTracks() { fNTracks++; };
+  void SetNTracks(Int_t ntracks) { fNTracks=ntracks; };
+  Int_t GetNTracks() { return fNTracks; };
   Double_t GetStubX() {return fStub[0];};
   Double_t GetStubXP() {return fStub[2];};
   Double_t GetStubY() {return fStub[1];};
@@ -90,6 +94,7 @@ protected:
   //std::vector<THcDCHit*> fHits;
   Double_t fStub[4];
   Bool_t fSetStubFlag;
+  Int_t fNTracks;
   // Should we also have a pointer back to the chamber object
 
   ClassDef(THcSpacePoint,0);   // Space Point/stub track in a single drift chamber
@@ -17,6 +17,16 @@
 
 #pragma link C++ class hallc::data::Hodoscope+;
 #pragma link C++ class hallc::data::DriftChamber+;
+// Version 1 stored plane maps, convert them to the plane arrays on read
+#pragma read sourceClass="hallc::data::DriftChamber" version="[1]" \
+  source="std::map<int,double> _Residuals; std::map<int,double> _ResidualsExclPlane; std::map<int,double> _Wire_hit_did; std::map<int,double> _Wire_hit_should" \
+  targetClass="hallc::data::DriftChamber" \
+  target="_NPlanes, _Residuals, _ResidualsExclPlane, _Wire_hit_did, _Wire_hit_should" \
+  code="{ using hallc::data::DriftChamber; \
+          newObj->_NPlanes = std::max({ DriftChamber::FromMap(onfile._Residuals, newObj->_Residuals), \
+                                        DriftChamber::FromMap(onfile._ResidualsExclPlane, newObj->_ResidualsExclPlane), \
+                                        DriftChamber::FromMap(onfile._Wire_hit_did, newObj->_Wire_hit_did), \
+                                        DriftChamber::FromMap(onfile._Wire_hit_should, newObj->_Wire_hit_should) }); }"
 
 #pragma link C++ class hallc::data::PulseWaveForm+;
 #pragma link C++ class std::vector<hallc::data::PulseWaveForm>+;
@@ -30,6 +40,7 @@
 
 #pragma link C++ class Decoder::Scaler9001+;
 #pragma link C++ class Decoder::Scaler9250+;
+#pragma link C++ class THcAdcPulseTable+;
 #pragma link C++ class THcAerogel+;
 #pragma link C++ class THcAerogelHit+;
 #pragma link C++ class THcAnalyzer+;
@@ -61,6 +72,7 @@
 #pragma link C++ class THcParmList+;
 #pragma link C++ class THcPeriodicReport+;
 #pragma link C++ class THcPrimaryKine+;
+#pragma link C++ class THcRNTupleOutput+;
 #pragma link C++ class THcRaster+;
 #pragma link C++ class THcRasteredBeam+;
 #pragma link C++ class THcRasterRawHit+;
@@ -72,6 +84,7 @@
 #pragma link C++ class THcRawTdcHit+;
 #pragma link C++ class THcReactionPoint+;
 #pragma link C++ class THcRun+;
+#pragma link C++ class THcMmapRun+;
 #pragma link C++ class THcRunParameters+;
 #pragma link C++ class THcScalerEvtHandler+;
 #pragma link C++ class THcScintillatorPlane+;
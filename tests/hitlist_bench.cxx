@@ -0,0 +1,157 @@
+#include <vector>
+#include <iostream>
+
+#include "TString.h"
+#include "TStopwatch.h"
+
+R__LOAD_LIBRARY(libHallC.so)
+#include "THcAnalyzer.h"
+#include "THcGlobals.h"
+#include "THcHallCSpectrometer.h"
+#include "THcDetectorMap.h"
+#include "THcDC.h"
+#include "THcParmList.h"
+#include "THcRun.h"
+#include "THaEvData.h"
+
+// Microbenchmark of THcHitList::DecodeToHitList on busy drift chamber
+// events.  The first NEvents physics events of the run are read into memory
+// and those with at least MinHits HMS plus SHMS DC hits are kept.  They are
+// then decoded NRepeat times into both DC hit lists with each way of
+// finding the hit of a counter:
+//
+//   search   - search the hit list, then sort it (as before the hit index)
+//   index    - (plane, counter) hit index, sort at the end if needed
+//   ordered  - hit index with ordered insertion, no sort (the default)
+//
+// Run it like elastic_coin_replay.cxx, from a replay directory:
+//
+//   hcana 'tests/hitlist_bench.cxx(RunNumber, NEvents, MinHits, NRepeat)'
+//
+// Returns 0, or 1 if nothing could be measured.
+
+Int_t hitlist_bench(Int_t RunNumber = 0, Int_t NEvents = 20000, Int_t MinHits = 200,
+                   Int_t NRepeat = 10) {
+  using namespace std;
+
+  if( RunNumber<=0 ) {
+    cerr << "hitlist_bench: no run number given" << endl;
+    std::exit(-1);
+  }
+
+  const char* RunFileNamePattern = "coin_all_%05d.dat";
+  vector<TString> pathList;
+  pathList.push_back(".");
+  pathList.push_back("./raw");
+  pathList.push_back("./raw/../raw.copiedtotape");
+  pathList.push_back("./cache");
+
+  // Load global parameters
+  gHcParms->Define("gen_run_number", "Run Number", RunNumber);
+  gHcParms->AddString("g_ctp_database_filename", "DBASE/COIN/standard.database");
+  gHcParms->Load(gHcParms->GetString("g_ctp_database_filename"), RunNumber);
+  gHcParms->Load(gHcParms->GetString("g_ctp_parm_filename"));
+  gHcParms->Load(gHcParms->GetString("g_ctp_kinematics_filename"), RunNumber);
+
+  // Load the Hall C detector map
+  gHcDetectorMap = new THcDetectorMap();
+  gHcDetectorMap->Load("MAPS/COIN/DETEC/coin.map");
+
+  // Only the drift chambers are needed
+  THcHallCSpectrometer* SHMS = new THcHallCSpectrometer("P", "SHMS");
+  gHaApps->Add(SHMS);
+  THcDC* pdc = new THcDC("dc", "Drift Chambers");
+  SHMS->AddDetector(pdc);
+  THcHallCSpectrometer* HMS = new THcHallCSpectrometer("H", "HMS");
+  gHaApps->Add(HMS);
+  THcDC* hdc = new THcDC("dc", "Drift Chambers");
+  HMS->AddDetector(hdc);
+
+  // Initialize the detectors and the decoder, but do not replay
+  THcAnalyzer* analyzer = new THcAnalyzer;
+  analyzer->SetCrateMapFileName("MAPS/db_cratemap.dat");
+  analyzer->SetOutFile(Form("ROOTfiles/hitlist_bench_%d.root", RunNumber));
+  THcRun* run = new THcRun( pathList, Form(RunFileNamePattern, RunNumber) );
+  run->SetRunParamClass("THcRunParameters");
+  if( analyzer->Init(run) != 0 ) {
+    cerr << "hitlist_bench: initialization failed" << endl;
+    std::exit(-1);
+  }
+  THaEvData* evdata = analyzer->GetDecoder();
+
+  // Read the busy events into memory.  Events of multi-event blocks are
+  // skipped, LoadEvent only decodes the first event of a block.
+  vector<vector<UInt_t>> events;
+  if( run->Open() != THaRunBase::READ_OK ) {
+    cerr << "hitlist_bench: cannot open the run file" << endl;
+    return 1;
+  }
+  Int_t nphysics = 0, nmultiblock = 0, nbad = 0;
+  Int_t status = THaRunBase::READ_OK;
+  while( nphysics < NEvents && (status = run->ReadEvent()) == THaRunBase::READ_OK ) {
+    const UInt_t* buffer = run->GetEvBuffer();
+    evdata->SetDataVersion(run->GetDataVersion());
+    if( evdata->LoadEvent(buffer) != THaEvData::HED_OK ) {
+      nbad++;
+      continue;
+    }
+    if( !evdata->IsPhysicsTrigger() ) {
+      continue;
+    }
+    if( evdata->IsMultiBlockMode() ) {
+      nmultiblock++;
+      continue;
+    }
+    nphysics++;
+    hdc->DecodeToHitList(*evdata, kTRUE);
+    pdc->DecodeToHitList(*evdata, kTRUE);
+    if( hdc->fNRawHits + pdc->fNRawHits >= (UInt_t)MinHits ) {
+      events.push_back(vector<UInt_t>(buffer, buffer + buffer[0] + 1));
+    }
+  }
+  run->Close();
+  if( nphysics < NEvents ) {
+    cout << "Stopped reading after " << nphysics << " of " << NEvents
+         << " physics events: "
+         << (status == THaRunBase::READ_EOF ? "end of run" : "read error") << endl;
+  }
+  if( nbad > 0 ) {
+    cout << "Skipped " << nbad << " events that failed to decode" << endl;
+  }
+  if( nmultiblock > 0 ) {
+    cout << "Skipped " << nmultiblock << " physics events in multi-event blocks" << endl;
+  }
+  cout << events.size() << " of " << nphysics << " physics events have at least "
+       << MinHits << " DC hits" << endl;
+  if( events.empty() ) {
+    cerr << "hitlist_bench: no events to measure, lower MinHits or use a "
+         << "run without multi-event blocks" << endl;
+    return 1;
+  }
+
+  const char* modes[] = { "search", "index", "ordered" };
+  for( Int_t mode = 0; mode < 3; mode++ ) {
+    for( THcDC* dc : { hdc, pdc } ) {
+      dc->SetUseHitIndex(mode > 0);
+      dc->SetOrderedInsert(mode > 1);
+    }
+    TStopwatch timer;
+    timer.Stop();
+    ULong64_t nhits = 0;
+    for( Int_t irep = 0; irep < NRepeat; irep++ ) {
+      for( const auto& ev : events ) {
+        evdata->LoadEvent(ev.data());
+        timer.Start(kFALSE);
+        hdc->DecodeToHitList(*evdata, kTRUE);
+        pdc->DecodeToHitList(*evdata, kTRUE);
+        timer.Stop();
+        nhits += hdc->fNRawHits + pdc->fNRawHits;
+      }
+    }
+    Double_t ndecoded = Double_t(events.size()) * NRepeat;
+    cout << Form("%-8s %8.2f us/event  %8.1f hits/event  (%.2f s cpu)",
+                 modes[mode], 1e6*timer.RealTime()/ndecoded, nhits/ndecoded,
+                 timer.CpuTime()) << endl;
+  }
+  return 0;
+}
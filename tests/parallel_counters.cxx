@@ -0,0 +1,123 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "TString.h"
+#include "TSystem.h"
+
+R__LOAD_LIBRARY(libHallC.so)
+#include "Scandalizer.h"
+#include "THcGlobals.h"
+#include "THcHallCSpectrometer.h"
+#include "THcDetectorMap.h"
+#include "THcCherenkov.h"
+#include "THcDC.h"
+#include "THcHodoscope.h"
+#include "THcShower.h"
+#include "THcParmList.h"
+#include "THaGoldenTrack.h"
+#include "THcScalerEvtHandler.h"
+#include "THcConfigEvtHandler.h"
+#include "THcRun.h"
+
+// Check of the event-parallel replay of hcana::Scandalizer.  The analyzer
+// counters after a replay with NWorkers worker processes must be the same
+// as after a serial replay of the same events.  Each call replays the first
+// MaxEvent physics events of the run with the HMS and writes the counter
+// summary to ROOTfiles/parallel_counters_<run>_<maxevent>_<nworkers>.txt.
+// parallel_counters.sh replays serially and with 4 workers and compares
+// the two files.  A MaxEvent smaller than the number of workers leaves
+// workers with an empty slice.
+//
+// Run it from a replay directory:
+//
+//   hcana -b -q 'tests/parallel_counters.cxx(RunNumber, MaxEvent, NWorkers)'
+
+// PrintCounters writes to cout
+class CounterScandalizer : public hcana::Scandalizer {
+public:
+  using hcana::Scandalizer::PrintCounters;
+};
+
+void parallel_counters(Int_t RunNumber = 0, Int_t MaxEvent = 2, Int_t NWorkers = 4) {
+  using namespace std;
+
+  if( RunNumber<=0 ) {
+    std::exit(-1);
+  }
+
+  const char* RunFileNamePattern = "coin_all_%05d.dat";
+  vector<TString> pathList;
+  pathList.push_back(".");
+  pathList.push_back("./raw");
+  pathList.push_back("./raw/../raw.copiedtotape");
+  pathList.push_back("./cache");
+
+  // Load global parameters
+  gHcParms->Define("gen_run_number", "Run Number", RunNumber);
+  gHcParms->AddString("g_ctp_database_filename", "DBASE/COIN/standard.database");
+  gHcParms->Load(gHcParms->GetString("g_ctp_database_filename"), RunNumber);
+  gHcParms->Load(gHcParms->GetString("g_ctp_parm_filename"));
+  gHcParms->Load(gHcParms->GetString("g_ctp_kinematics_filename"), RunNumber);
+
+  // Load the Hall C detector map
+  gHcDetectorMap = new THcDetectorMap();
+  gHcDetectorMap->Load("MAPS/COIN/DETEC/coin.map");
+
+  // HMS with its detectors, golden track and scalers
+  THcHallCSpectrometer* HMS = new THcHallCSpectrometer("H", "HMS");
+  HMS->SetEvtType(2);
+  HMS->AddEvtType(4);
+  HMS->AddEvtType(5);
+  HMS->AddEvtType(6);
+  HMS->AddEvtType(7);
+  gHaApps->Add(HMS);
+  HMS->AddDetector(new THcDC("dc", "Drift Chambers"));
+  HMS->AddDetector(new THcHodoscope("hod", "Hodoscope"));
+  HMS->AddDetector(new THcCherenkov("cer", "Heavy Gas Cherenkov"));
+  HMS->AddDetector(new THcShower("cal", "Calorimeter"));
+  gHaPhysics->Add(new THaGoldenTrack("H.gtr", "HMS Golden Track", "H"));
+
+  THcScalerEvtHandler* hscaler = new THcScalerEvtHandler("H", "Hall C scaler event type 4");
+  hscaler->AddEvtType(2);
+  hscaler->AddEvtType(4);
+  hscaler->AddEvtType(5);
+  hscaler->AddEvtType(6);
+  hscaler->AddEvtType(7);
+  hscaler->AddEvtType(129);
+  hscaler->SetDelayedType(129);
+  hscaler->SetUseFirstEvent(kTRUE);
+  gHaEvtHandlers->Add(hscaler);
+  gHaEvtHandlers->Add(new THcConfigEvtHandler("HC", "Config Event type 125"));
+
+  CounterScandalizer* analyzer = new CounterScandalizer;
+  analyzer->SetNWorkers(NWorkers);
+  analyzer->SetCountMode(0);  // Slices are counted in physics events
+
+  THcRun* run = new THcRun( pathList, Form(RunFileNamePattern, RunNumber) );
+  run->SetRunParamClass("THcRunParameters");
+  run->SetEventRange(1, MaxEvent);
+  run->SetNscan(1);
+  run->SetDataRequired(0x7);
+
+  analyzer->SetEpicsEvtType(180);
+  analyzer->SetCrateMapFileName("MAPS/db_cratemap.dat");
+  analyzer->SetOutFile(Form("ROOTfiles/parallel_counters_%d_%d_%d.root",
+                            RunNumber, MaxEvent, NWorkers));
+  analyzer->SetOdefFile("DEF-files/COIN/PRODUCTION/coin_production_hElec_pProt.def");
+  analyzer->SetCutFile("DEF-files/COIN/PRODUCTION/CUTS/coin_production_cuts.def");
+  if( analyzer->Process(run) < 0 ) {
+    cerr << "parallel_counters: replay with " << NWorkers << " workers failed" << endl;
+    std::exit(1);
+  }
+
+  TString countfile = Form("ROOTfiles/parallel_counters_%d_%d_%d.txt",
+                           RunNumber, MaxEvent, NWorkers);
+  if( gSystem->RedirectOutput(countfile, "w") != 0 ) {
+    cerr << "parallel_counters: cannot write " << countfile << endl;
+    std::exit(1);
+  }
+  analyzer->PrintCounters();
+  gSystem->RedirectOutput(nullptr);
+  cout << "Counters written to " << countfile << endl;
+}
@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Compare the analyzer counters of a serial and a 4-worker event-parallel
+# replay (tests/parallel_counters.cxx).  Run from a replay directory:
+#
+#   tests/parallel_counters.sh RunNumber [MaxEvent ...]
+#
+# The default event limits are 2 (fewer physics events than workers, so
+# two workers have an empty slice) and 1000.
+
+if [ $# -lt 1 ]; then
+  echo "usage: $0 RunNumber [MaxEvent ...]"
+  exit 2
+fi
+run=$1
+shift
+maxevents=${@:-"2 1000"}
+
+status=0
+for maxev in ${maxevents}; do
+  for nworkers in 1 4; do
+    if ! hcana -b -q "tests/parallel_counters.cxx(${run},${maxev},${nworkers})"; then
+      echo "replay of run ${run} with ${nworkers} workers failed"
+      exit 1
+    fi
+  done
+  serial=ROOTfiles/parallel_counters_${run}_${maxev}_1.txt
+  parallel=ROOTfiles/parallel_counters_${run}_${maxev}_4.txt
+  if diff ${serial} ${parallel}; then
+    echo "run ${run}, ${maxev} events: counters match"
+  else
+    echo "run ${run}, ${maxev} events: counters of the 4-worker replay differ"
+    status=1
+  fi
+done
+exit ${status}
@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------*
+ *
+ * Description:
+ *      Build the event index (see THcEventIndex) of CODA run files, so that
+ *      hcana can seek to an event number or event type without reading the
+ *      whole run.  The index is written next to each run as <file>.idx.
+ *
+ *      Usage: hcana_index [-f] file.dat [file.dat ...]
+ *             -f  rebuild indexes that already exist
+ *
+ *----------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+
+#include "THcMmapRun.h"
+#include "THcEventIndex.h"
+
+
+static int BuildIndex(const char* rawfile, bool force)
+{
+    TString idxfile = THcEventIndex::IndexFileName(rawfile);
+    THcEventIndex index;
+    if (!force && index.Read(idxfile, rawfile) == 0) {
+        printf("%s: index up to date, %zu events\n", rawfile, index.GetSize());
+        return 0;
+    }
+
+    THcMmapRun run(rawfile);
+    if (run.Open() != THaRunBase::READ_OK) {
+        fprintf(stderr, "%s: cannot open\n", rawfile);
+        return 1;
+    }
+    if (!run.IsMapped()) {
+        fprintf(stderr, "%s: cannot map file, no index built\n", rawfile);
+        run.Close();
+        return 1;
+    }
+
+    index.Clear();
+    int status;
+    while ((status = run.ReadEvent()) == THaRunBase::READ_OK) {
+        index.AddEvent(run.GetEvBuffer(), run.GetEventOffset(), run.GetEventBlock(),
+                       run.GetEvioVersion());
+    }
+    run.Close();
+    if (status != THaRunBase::READ_EOF) {
+        fprintf(stderr, "%s: read error after %zu events, no index written\n",
+                rawfile, index.GetSize());
+        return 1;
+    }
+
+    if (index.Write(idxfile, rawfile) != 0) {
+        fprintf(stderr, "%s: cannot write %s\n", rawfile, idxfile.Data());
+        return 1;
+    }
+    printf("%s: %zu events, %llu physics events -> %s\n", rawfile, index.GetSize(),
+           (unsigned long long) index.GetNPhysics(), idxfile.Data());
+    return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+    bool force = false;
+    int nfiles = 0, nerrors = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0) {
+            force = true;
+            continue;
+        }
+        nerrors += BuildIndex(argv[i], force);
+        nfiles++;
+    }
+
+    if (nfiles == 0) {
+        fprintf(stderr, "Usage: %s [-f] file.dat [file.dat ...]\n", argv[0]);
+        return 2;
+    }
+    return nerrors ? 1 : 0;
+}